@@ -16,7 +16,7 @@ void loopHandler() {
   if (millis() - lastTemperatureSent >= temperatureIntervalSetting.get() * 1000UL || lastTemperatureSent == 0) {
     float temperature = 22; // Fake temperature here, for the example
     Homie.getLogger() << "Temperature: " << temperature << " °C" << endl;
-    temperatureNode.setProperty("degrees").send(String(temperature));
+    temperatureNode.setProperty("degrees").send(temperature);
     lastTemperatureSent = millis();
   }
 }
@@ -0,0 +1,70 @@
+#include "harness.hpp"
+
+static uint64_t allocationCount = 0;
+
+void* operator new(size_t size) {
+  allocationCount++;
+  void* pointer = malloc(size ? size : 1);
+  if (!pointer) throw std::bad_alloc();
+  return pointer;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+  free(pointer);
+}
+
+void Harness::configure(const char* deviceId, const char* baseTopic) {
+  Homie_setFirmware("benchmark", "1.0.0");
+  Homie.disableLogging();
+  Homie.disableLedFeedback();
+
+  ConfigStruct& config = Interface::get().getConfig()._configStruct;
+  strlcpy(config.name, "Benchmark", sizeof(config.name));
+  strlcpy(config.deviceId, deviceId, sizeof(config.deviceId));
+  config.deviceStatsInterval = STATS_SEND_INTERVAL_SEC;
+  strlcpy(config.wifi.ssid, "ssid", sizeof(config.wifi.ssid));
+  strlcpy(config.mqtt.server.host, "broker", sizeof(config.mqtt.server.host));
+  config.mqtt.server.port = 1883;
+  strlcpy(config.mqtt.baseTopic, baseTopic, sizeof(config.mqtt.baseTopic));
+  config.mqtt.auth = false;
+  config.ota.enabled = false;
+  Interface::get().getConfig()._valid = true;
+}
+
+BootNormal& Harness::bootNormal() {
+  Homie._bootNormal.setup();
+  return Homie._bootNormal;
+}
+
+void Harness::deliver(const char* topic, const char* payload) {
+  // the library splits the topic in place, like AsyncMqttClient lets it
+  static char topicBuffer[MAX_MQTT_TOPIC_LENGTH + 1];
+  static char payloadBuffer[256];
+  strcpy(topicBuffer, Interface::get().getConfig().get().mqtt.baseTopic);
+  strcat(topicBuffer, topic);
+  size_t length = strlen(payload);
+  memcpy(payloadBuffer, payload, length);
+
+  AsyncMqttClientMessageProperties properties = { .qos = 1, .dup = false, .retain = false };
+  Interface::get().getMqttClient().messageCallback(topicBuffer, payloadBuffer, properties, length, 0, length);
+}
+
+uint64_t Harness::getAllocationCount() {
+  return allocationCount;
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+// Shared by the benchmarks: the library internals, a configured device, timing and allocation counting
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Arduino.h"
+#include "ArduinoJson.h"
+#include "AsyncMqttClient.h"
+#include "Bounce2.h"
+#include "DNSServer.h"
+#include "ESP8266HTTPClient.h"
+#include "ESP8266WiFi.h"
+#include "ESP8266mDNS.h"
+#include "ESPAsyncTCP.h"
+#include "ESPAsyncWebServer.h"
+#include "FS.h"
+#include "IPAddress.h"
+#include "Ticker.h"
+#include "libb64/cdecode.h"
+
+// The benchmarks measure private library code, so access control is lifted for their translation units only.
+// Everything else is included above, so that only the library classes are affected.
+#define private public
+#define protected public
+#include "Homie.hpp"
+#undef private
+#undef protected
+
+using namespace HomieInternals;
+
+namespace Harness {
+// Fills in the configuration that Config::load() would read from SPIFFS, and silences the logger
+void configure(const char* deviceId = "device", const char* baseTopic = "homie/");
+
+// Runs BootNormal::setup() on the library instance, which freezes the nodes and builds the routes
+BootNormal& bootNormal();
+
+// Delivers a complete message as AsyncMqttClient would, the topic being prefixed with the base topic
+void deliver(const char* topic, const char* payload);
+
+uint64_t getAllocationCount();
+
+class Stopwatch {
+ public:
+  Stopwatch() : _startedAt(std::chrono::steady_clock::now()) {}
+  double getSeconds() const { return std::chrono::duration<double>(std::chrono::steady_clock::now() - _startedAt).count(); }
+
+ private:
+  std::chrono::steady_clock::time_point _startedAt;
+};
+
+// Keeps the optimizer from removing a measured result
+template <typename T>
+inline void keep(const T& value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+}  // namespace Harness
@@ -0,0 +1,69 @@
+#include "legacy.hpp"
+
+// Heap allocations per /set message, from the MQTT callback to the handler that handles it
+
+static const uint32_t MESSAGES_COUNT = 1000;
+
+class StringOverrideNode : public HomieNode {
+ public:
+  StringOverrideNode() : HomieNode("override", "benchmark") {}
+
+ protected:
+  bool handleInput(const String& property, const HomieRange& range, const String& value) override { return true; }
+};
+
+static bool viewHandler(const HomieRange& range, const HomieStringView& value) { return true; }
+static bool stringHandler(const HomieRange& range, const String& value) { return true; }
+
+static double measure(const char* topic, const std::function<void(const char* topic)>& deliver) {
+  deliver(topic);  // grows the reused buffers
+
+  uint64_t allocationCount = Harness::getAllocationCount();
+  for (uint32_t i = 0; i < MESSAGES_COUNT; i++) deliver(topic);
+  return static_cast<double>(Harness::getAllocationCount() - allocationCount) / MESSAGES_COUNT;
+}
+
+static double measureLegacy(const char* topic) {
+  Legacy::Router router;
+  return measure(topic, [&router](const char* topic) {
+    char topicBuffer[MAX_MQTT_TOPIC_LENGTH + 1];
+    char payload[] = "21.5";
+    strcpy(topicBuffer, Interface::get().getConfig().get().mqtt.baseTopic);
+    strcat(topicBuffer, topic);
+    router.onMqttMessage(topicBuffer, payload, strlen(payload), 0, strlen(payload));
+  });
+}
+
+static double measureBootNormal(const char* topic) {
+  return measure(topic, [](const char* topic) { Harness::deliver(topic, "21.5"); });
+}
+
+int main() {
+  Harness::configure();
+
+  // nodes live as long as the firmware
+  (new HomieNode("plain", "benchmark"))->advertise("view").settable(viewHandler);
+  (new HomieNode("adapter", "benchmark"))->advertise("string").settable(stringHandler);
+  (new HomieNode("handler", "benchmark", [](const String& property, const HomieRange& range, const String& value) { return true; }))->advertise("property").settable(viewHandler);
+  (new StringOverrideNode())->advertise("property").settable(viewHandler);
+  Harness::bootNormal();
+
+  printf("Heap allocations per /set message\n");
+  double before = measureLegacy("device/adapter/string/set");
+  double after = measureBootNormal("device/plain/view/set");
+  printf("  %-52s %5.2f\n", "before, String handlers", before);
+  printf("  %-52s %5.2f\n", "after, view property handler", after);
+  printf("  %-52s %5.2f\n", "after, String property handler", measureBootNormal("device/adapter/string/set"));
+  printf("  %-52s %5.2f\n", "after, String node handler", measureBootNormal("device/handler/property/set"));
+  printf("  %-52s %5.2f\n", "after, String handleInput() override", measureBootNormal("device/override/property/set"));
+
+  Homie.setGlobalInputHandler([](const HomieNode& node, const String& property, const HomieRange& range, const String& value) { return true; });
+  printf("  %-52s %5.2f\n", "after, String global handler", measureBootNormal("device/plain/view/set"));
+
+  if (after != 0) {
+    printf("✖ view handlers should not allocate\n");
+    return 1;
+  }
+
+  return 0;
+}
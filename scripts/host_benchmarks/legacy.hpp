@@ -0,0 +1,30 @@
+#pragma once
+
+#include "harness.hpp"
+
+// The inbound path as it was before the routing table, the level index, the view handlers and the node index, kept so that the benchmarks can compare against it
+namespace Legacy {
+class Router {
+ public:
+  Router();
+  void onMqttMessage(char* topic, char* payload, size_t len, size_t index, size_t total);
+
+  std::function<bool(const HomieNode& node, const String& property, const HomieRange& range, const String& value)> globalInputHandler;
+
+ private:
+  std::unique_ptr<char*[]> _mqttTopicLevels;
+  uint8_t _mqttTopicLevelsCount;
+  std::unique_ptr<char[]> _mqttPayloadBuffer;
+
+  void __splitTopic(char* topic);
+  bool __fillPayloadBuffer(char* payload, size_t len, size_t index, size_t total);
+  bool __handleBroadcasts();
+  bool __handleResets();
+  bool __handleConfig();
+  bool __handleNodeProperty();
+};
+
+// linear scans over HomieNode::nodes and the properties of the node
+HomieNode* find(const char* id);
+Property* findProperty(const HomieNode& node, const char* property);
+}  // namespace Legacy
@@ -0,0 +1,73 @@
+#include "legacy.hpp"
+
+// Node and property lookups from 1 to 500 nodes, through the index frozen at setup against the previous linear scans
+
+static const uint8_t PROPERTIES_COUNT = 8;  // per node
+static const uint32_t LOOKUPS_COUNT = 200000;
+static const uint16_t NODES_COUNTS[] = { 1, 5, 10, 25, 50, 100, 250, 500 };
+
+struct Lookup {
+  std::string node;
+  std::string property;
+};
+
+static void registerNode(uint16_t index) {
+  char id[16];
+  snprintf(id, sizeof(id), "node%u", index);
+  HomieNode* node = new HomieNode(strdup(id), "benchmark");  // nodes live as long as the firmware
+
+  for (uint8_t i = 0; i < PROPERTIES_COUNT; i++) {
+    char property[16];
+    snprintf(property, sizeof(property), "property%u", i);
+    node->advertise(strdup(property)).settable();
+  }
+}
+
+int main() {
+  Harness::configure();
+
+  printf("Node and property lookups, %u properties per node, ns per lookup\n", PROPERTIES_COUNT);
+  printf("  %6s %14s %14s %9s %14s\n", "nodes", "linear scans", "index", "speedup", "index build");
+
+  srand(1);
+  for (uint16_t nodesCount : NODES_COUNTS) {
+    while (HomieNode::nodes.size() < nodesCount) registerNode(HomieNode::nodes.size());
+
+    Harness::Stopwatch buildStopwatch;
+    HomieNode::buildIndex();
+    double buildSeconds = buildStopwatch.getSeconds();
+
+    std::vector<Lookup> lookups;
+    for (uint16_t i = 0; i < 1024; i++) {
+      lookups.push_back({ "node" + std::to_string(rand() % nodesCount), "property" + std::to_string(rand() % PROPERTIES_COUNT) });
+    }
+
+    Harness::Stopwatch linearStopwatch;
+    for (uint32_t i = 0; i < LOOKUPS_COUNT; i++) {
+      const Lookup& lookup = lookups[i % lookups.size()];
+      HomieNode* node = Legacy::find(lookup.node.c_str());
+      Harness::keep(Legacy::findProperty(*node, lookup.property.c_str()));
+    }
+    double linearSeconds = linearStopwatch.getSeconds();
+
+    Harness::Stopwatch indexStopwatch;
+    for (uint32_t i = 0; i < LOOKUPS_COUNT; i++) {
+      const Lookup& lookup = lookups[i % lookups.size()];
+      HomieNode* node;
+      Harness::keep(HomieNode::findProperty(lookup.node.c_str(), lookup.property.c_str(), &node));
+    }
+    double indexSeconds = indexStopwatch.getSeconds();
+
+    for (const Lookup& lookup : lookups) {
+      HomieNode* node;
+      if (HomieNode::findProperty(lookup.node.c_str(), lookup.property.c_str(), &node) != Legacy::findProperty(*Legacy::find(lookup.node.c_str()), lookup.property.c_str())) {
+        printf("✖ %s/%s resolved differently\n", lookup.node.c_str(), lookup.property.c_str());
+        return 1;
+      }
+    }
+
+    printf("  %6u %14.1f %14.1f %8.1fx %11.1f us\n", nodesCount, linearSeconds * 1e9 / LOOKUPS_COUNT, indexSeconds * 1e9 / LOOKUPS_COUNT, linearSeconds / indexSeconds, buildSeconds * 1e6);
+  }
+
+  return 0;
+}
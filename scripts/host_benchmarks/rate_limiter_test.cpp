@@ -0,0 +1,107 @@
+#include "harness.hpp"
+
+// Token refill and burst limit of the device limit, COALESCE ordering, and a coalesced value kept when the MQTT client refuses it
+
+static std::vector<std::string> published;  // property=payload, in publish order
+
+static bool expectPublished(const char* step, const std::vector<std::string>& expected) {
+  if (published == expected) {
+    published.clear();
+    return true;
+  }
+
+  printf("✖ %s: published", step);
+  for (const std::string& value : published) printf(" %s", value.c_str());
+  printf(" instead of");
+  for (const std::string& value : expected) printf(" %s", value.c_str());
+  printf("\n");
+  return false;
+}
+
+int main() {
+  Harness::configure();
+  Interface::get().ready = true;
+  Interface::get().getMqttClient().isConnected = true;
+
+  HomieNode* node = new HomieNode("node", "test");
+  node->advertise("a");
+  node->advertise("b");
+  Harness::bootNormal();
+
+  AsyncMqttClient& mqttClient = Interface::get().getMqttClient();
+  RateLimiter& rateLimiter = Interface::get().getRateLimiter();
+  const size_t prefixLength = strlen("homie/device/node/");
+  mqttClient.publishObserver = [&](const char* topic, const char* payload, size_t length, uint16_t packetId) {
+    published.push_back(std::string(topic + prefixLength) + "=" + std::string(payload, length));
+    Interface::get().getPublishTracker().acknowledge(packetId);  // the broker answers right away
+  };
+
+  printf("Rate limiter, device limit of 10 values/s with a burst of 3\n");
+
+  // burst limit, then one token every 100 ms
+  rateLimiter.setup(10, 3, HomieRateLimitPolicy::DROP);
+  for (uint8_t i = 1; i <= 5; i++) node->setProperty("a").send(String(i));
+  if (!expectPublished("burst", { "a=1", "a=2", "a=3" })) return 1;
+
+  Host::advance(99000);
+  node->setProperty("a").send("6");
+  Host::advance(1000);
+  node->setProperty("a").send("7");
+  node->setProperty("a").send("8");
+  if (!expectPublished("refill", { "a=7" })) return 1;
+
+  // the bucket never holds more than the burst
+  Host::advance(10000000);
+  for (uint8_t i = 9; i <= 12; i++) node->setProperty("a").send(String(i));
+  if (!expectPublished("refill after idling", { "a=9", "a=10", "a=11" })) return 1;
+  printf("  %-34s %12u\n", "values dropped", rateLimiter.getHitCount());
+
+  // coalesced values go out in the order their topics were first held back, each with its latest value
+  rateLimiter.setup(1, 1, HomieRateLimitPolicy::COALESCE);
+  std::vector<bool> completions;
+  node->setProperty("a").send("1");
+  node->setProperty("a").setQos(0).setCompletionHandler([&](bool delivered) { completions.push_back(delivered); }).send("2");
+  node->setProperty("b").send("1");
+  node->setProperty("a").send("3");
+  rateLimiter.loop();
+  if (!expectPublished("coalesce", { "a=1" })) return 1;
+  if (completions.size() != 1 || completions[0]) {
+    printf("✖ The completion handler of the superseded value was not called with false\n");
+    return 1;
+  }
+
+  Host::advance(1000000);
+  rateLimiter.loop();
+  rateLimiter.loop();
+  Host::advance(1000000);
+  rateLimiter.loop();
+  if (!expectPublished("coalesced release", { "a=3", "b=1" })) return 1;
+
+  // a newer value that gets a token discards the held back one
+  Host::advance(1000000);
+  node->setProperty("a").send("4");
+  node->setProperty("a").send("5");
+  Host::advance(1000000);
+  node->setProperty("a").send("6");
+  Host::advance(1000000);
+  rateLimiter.loop();
+  if (!expectPublished("coalesced value superseded", { "a=4", "a=6" })) return 1;
+
+  // the MQTT client refuses the coalesced value, which is kept along with its token
+  node->setProperty("a").send("7");
+  node->setProperty("a").send("8");
+  Host::advance(1000000);
+  mqttClient.acceptPublishes = false;
+  rateLimiter.loop();
+  mqttClient.acceptPublishes = true;
+  if (!expectPublished("refused", { "a=7" })) return 1;
+  if (!rateLimiter.hasTokens(nullptr, 1)) {
+    printf("✖ The token of the refused value was not refunded\n");
+    return 1;
+  }
+  rateLimiter.loop();
+  if (!expectPublished("retried", { "a=8" })) return 1;
+  printf("  %-34s %12s\n", "COALESCE ordering and retries", "ok");
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+#include "legacy.hpp"
+
+// Inbound messages per second through the routing table built by BootNormal::setup(), against the previous handler chain
+
+static const uint8_t NODES_COUNT = 8;
+static const uint8_t PROPERTIES_COUNT = 8;  // per node, the last one being a range
+static const uint32_t ROUNDS = 5000;
+
+static uint32_t handledCount = 0;
+
+struct Message {
+  std::string topic;  // after the base topic
+  std::string payload;
+};
+
+static void registerNodes() {
+  for (uint8_t i = 0; i < NODES_COUNT; i++) {
+    char id[16];
+    snprintf(id, sizeof(id), "node%u", i);
+    HomieNode* node = new HomieNode(strdup(id), "benchmark");  // nodes live as long as the firmware
+
+    for (uint8_t j = 0; j < PROPERTIES_COUNT - 1; j++) {
+      char property[16];
+      snprintf(property, sizeof(property), "property%u", j);
+      node->advertise(strdup(property)).settable([](const HomieRange& range, const HomieStringView& value) {
+        handledCount++;
+        return true;
+      });
+    }
+    node->advertiseRange("range", 1, 16).settable([](const HomieRange& range, const HomieStringView& value) {
+      handledCount++;
+      return true;
+    });
+  }
+
+  Homie.setBroadcastHandler([](const String& level, const String& value) {
+    handledCount++;
+    return true;
+  });
+}
+
+static std::vector<Message> buildMessages() {
+  std::vector<Message> messages;
+  for (uint8_t i = 0; i < NODES_COUNT; i++) {
+    for (uint8_t j = 0; j < PROPERTIES_COUNT - 1; j++) {
+      messages.push_back({ "device/node" + std::to_string(i) + "/property" + std::to_string(j) + "/set", "21.5" });
+    }
+    messages.push_back({ "device/node" + std::to_string(i) + "/range_" + std::to_string(i + 1) + "/set", "on" });
+  }
+  messages.push_back({ "$broadcast/alert", "Intruder detected" });
+  messages.push_back({ "device/$implementation/reset", "false" });
+  messages.push_back({ "other-device/node0/property0/set", "21.5" });
+  messages.push_back({ "device/unknown/property0/set", "21.5" });
+
+  return messages;
+}
+
+static double measureLegacy(const std::vector<Message>& messages) {
+  Legacy::Router router;
+  char topic[MAX_MQTT_TOPIC_LENGTH + 1];
+  char payload[64];
+
+  Harness::Stopwatch stopwatch;
+  for (uint32_t round = 0; round < ROUNDS; round++) {
+    for (const Message& message : messages) {
+      strcpy(topic, Interface::get().getConfig().get().mqtt.baseTopic);
+      strcat(topic, message.topic.c_str());
+      memcpy(payload, message.payload.data(), message.payload.size());
+      router.onMqttMessage(topic, payload, message.payload.size(), 0, message.payload.size());
+    }
+  }
+  return stopwatch.getSeconds();
+}
+
+static double measureRoutingTable(const std::vector<Message>& messages) {
+  Harness::Stopwatch stopwatch;
+  for (uint32_t round = 0; round < ROUNDS; round++) {
+    for (const Message& message : messages) {
+      Harness::deliver(message.topic.c_str(), message.payload.c_str());
+    }
+  }
+  return stopwatch.getSeconds();
+}
+
+int main() {
+  Harness::configure();
+  registerNodes();
+  Harness::bootNormal();
+
+  std::vector<Message> messages = buildMessages();
+  uint32_t messagesCount = messages.size() * ROUNDS;
+  printf("Inbound routing, %u nodes of %u properties, %u topics, %u messages\n", NODES_COUNT, PROPERTIES_COUNT, static_cast<unsigned>(messages.size()), messagesCount);
+
+  handledCount = 0;
+  double legacySeconds = measureLegacy(messages);
+  uint32_t legacyHandledCount = handledCount;
+
+  handledCount = 0;
+  double routingTableSeconds = measureRoutingTable(messages);
+  uint32_t routingTableHandledCount = handledCount;
+
+  printf("  %-24s %10.0f msg/s  %u handled\n", "handler chain (before)", messagesCount / legacySeconds, legacyHandledCount);
+  printf("  %-24s %10.0f msg/s  %u handled\n", "routing table (after)", messagesCount / routingTableSeconds, routingTableHandledCount);
+  printf("  speedup x%.2f\n", legacySeconds / routingTableSeconds);
+
+  if (legacyHandledCount != routingTableHandledCount) {
+    printf("✖ both paths should dispatch the same messages\n");
+    return 1;
+  }
+
+  return 0;
+}
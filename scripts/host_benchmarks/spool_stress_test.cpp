@@ -0,0 +1,137 @@
+#include "harness.hpp"
+
+// Spool append throughput, wrap-around, recovery after a reboot and replay time, on the in-memory SPIFFS
+
+static const uint16_t CAPACITY = 512;  // records
+static const uint16_t REPLAY_RATE = 20;  // records per second
+static const uint32_t APPENDS_COUNT = 20000;  // wraps around the ring many times
+static const char* TOPIC = "homie/device/sensor/temperature";
+
+static uint32_t parseSequence(const char* payload, size_t length) {
+  char sequenceStr[16];
+  memcpy(sequenceStr, payload, length);
+  sequenceStr[length] = '\0';
+  return strtoul(sequenceStr, nullptr, 10);
+}
+
+int main() {
+  Harness::configure();
+  SPIFFS.format();
+
+  const size_t fileSize = sizeof(Spool::Header) + CAPACITY * sizeof(Spool::Record);
+  printf("Spool of %u records of %u bytes, %u appends, replayed at %u records/s\n", CAPACITY, SPOOL_RECORD_SIZE, APPENDS_COUNT, REPLAY_RATE);
+
+  // appends, the ring wraps around and drops the oldest records
+  std::unique_ptr<Spool> spool(new Spool());
+  if (!spool->setup(CAPACITY, REPLAY_RATE)) {
+    printf("✖ Cannot set up the spool\n");
+    return 1;
+  }
+
+  SPIFFS.getStats() = {};
+  Harness::Stopwatch appendStopwatch;
+  for (uint32_t sequence = 1; sequence <= APPENDS_COUNT; sequence++) {
+    char payload[10 + 1];
+    size_t length = snprintf(payload, sizeof(payload), "%u", sequence);
+    if (!spool->append(TOPIC, 1, true, payload, length)) {
+      printf("✖ Append %u refused\n", sequence);
+      return 1;
+    }
+    Host::advance(1000);
+  }
+  spool->flush();
+  double appendSeconds = appendStopwatch.getSeconds();
+  FS::Stats appendStats = SPIFFS.getStats();
+
+  File spoolFile = SPIFFS.open(SPOOL_FILE_PATH, "r");
+  size_t spoolFileSize = spoolFile.size();
+  spoolFile.close();
+
+  printf("  %-34s %12.0f\n", "appends per second", APPENDS_COUNT / appendSeconds);
+  printf("  %-34s %12.3f\n", "file opens per record", static_cast<double>(appendStats.opens) / APPENDS_COUNT);
+  printf("  %-34s %12.3f\n", "flash writes per record", static_cast<double>(appendStats.writes) / APPENDS_COUNT);
+  printf("  %-34s %12.1f\n", "bytes written per record", static_cast<double>(appendStats.bytesWritten) / APPENDS_COUNT);
+  printf("  %-34s %12zu\n", "file size in bytes", spoolFileSize);
+
+  if (spoolFileSize != fileSize) {
+    printf("✖ The file grew to %zu bytes instead of %zu\n", spoolFileSize, fileSize);
+    return 1;
+  }
+  if (spool->getPendingCount() != CAPACITY || spool->getDroppedCount() != APPENDS_COUNT - CAPACITY) {
+    printf("✖ %u pending and %u dropped records instead of %u and %u\n", spool->getPendingCount(), spool->getDroppedCount(), CAPACITY, APPENDS_COUNT - CAPACITY);
+    return 1;
+  }
+
+  // reboot, the write position is recovered from the records
+  spool.reset(new Spool());
+  Harness::Stopwatch recoveryStopwatch;
+  spool->setup(CAPACITY, REPLAY_RATE);
+  double recoverySeconds = recoveryStopwatch.getSeconds();
+
+  printf("  %-34s %12.1f\n", "recovery after a reboot in us", recoverySeconds * 1e6);
+
+  if (spool->getPendingCount() != CAPACITY) {
+    printf("✖ %u pending records after the reboot instead of %u\n", spool->getPendingCount(), CAPACITY);
+    return 1;
+  }
+
+  // replay at the configured rate, in order, with the MQTT client refusing some publishes
+  AsyncMqttClient& mqttClient = Interface::get().getMqttClient();
+  uint32_t expectedSequence = APPENDS_COUNT - CAPACITY + 1;
+  uint32_t replayedCount = 0;
+  bool inOrder = true;
+  std::vector<uint16_t> unacknowledgedPacketIds;
+  mqttClient.publishObserver = [&](const char* topic, const char* payload, size_t length, uint16_t packetId) {
+    if (strcmp(topic, TOPIC) != 0 || parseSequence(payload, length) != expectedSequence) inOrder = false;
+    expectedSequence++;
+    replayedCount++;
+    unacknowledgedPacketIds.push_back(packetId);
+  };
+
+  uint64_t replayStartedAt = Host::clockMicros;
+  uint32_t loopsCount = 0;
+  bool rebooted = false;
+  Harness::Stopwatch replayStopwatch;
+  while (!spool->isEmpty()) {
+    mqttClient.acceptPublishes = loopsCount % 7 != 0;
+    spool->replay();
+    for (uint16_t packetId : unacknowledgedPacketIds) Interface::get().getPublishTracker().acknowledge(packetId);  // the broker answers within the loop
+    unacknowledgedPacketIds.clear();
+    Host::advance(1000);
+    loopsCount++;
+
+    // reboot in the middle of the replay, the replayed records are not replayed twice
+    if (!rebooted && replayedCount == CAPACITY / 2 + 3) {
+      spool.reset(new Spool());
+      spool->setup(CAPACITY, REPLAY_RATE);
+      if (spool->getPendingCount() != CAPACITY - replayedCount) {
+        printf("✖ %u records to replay after a reboot in the middle of the replay instead of %u\n", spool->getPendingCount(), CAPACITY - replayedCount);
+        return 1;
+      }
+      rebooted = true;
+    }
+  }
+  double replaySeconds = replayStopwatch.getSeconds();
+  double simulatedSeconds = (Host::clockMicros - replayStartedAt) / 1e6;
+  mqttClient.acceptPublishes = true;
+  mqttClient.publishObserver = nullptr;
+
+  printf("  %-34s %12.2f\n", "replay host time per record in us", replaySeconds * 1e6 / CAPACITY);
+  printf("  %-34s %12.1f\n", "replay simulated time in s", simulatedSeconds);
+  printf("  %-34s %12.1f\n", "replay expected time in s", static_cast<double>(CAPACITY) / REPLAY_RATE);
+
+  if (!inOrder || replayedCount != CAPACITY) {
+    printf("✖ %u records replayed, %s\n", replayedCount, inOrder ? "in order" : "out of order");
+    return 1;
+  }
+
+  // reboot again, the replayed records are not replayed twice
+  spool.reset(new Spool());
+  spool->setup(CAPACITY, REPLAY_RATE);
+  if (!spool->isEmpty()) {
+    printf("✖ %u records to replay again after the reboot\n", spool->getPendingCount());
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,254 @@
+#pragma once
+
+// Just enough of the ESP8266 Arduino core to build and run the library on the host
+// Time is simulated: millis() and micros() only move when Host::advance() is called
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <ctype.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
+
+typedef uint8_t byte;
+typedef const char* PGM_P;
+class __FlashStringHelper;
+
+#define PROGMEM
+#define ICACHE_RAM_ATTR
+#define PSTR(s) (s)
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(PSTR(s)))
+#define FPSTR(p) (reinterpret_cast<const __FlashStringHelper*>(p))
+
+#define LOW 0
+#define HIGH 1
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define LED_BUILTIN 2
+
+namespace Host {
+extern uint64_t clockMicros;
+inline void advance(uint32_t micros) { clockMicros += micros; }
+}  // namespace Host
+
+inline unsigned long millis() { return static_cast<unsigned long>(Host::clockMicros / 1000); }
+inline unsigned long micros() { return static_cast<unsigned long>(Host::clockMicros); }
+inline void delay(unsigned long ms) { Host::advance(ms * 1000); }
+inline void yield() {}
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return HIGH; }
+inline long random(long min, long max) { return min + rand() % (max - min); }
+
+inline int strcmp_P(const char* a, const char* b) { return strcmp(a, b); }
+inline int strncmp_P(const char* a, const char* b, size_t n) { return strncmp(a, b, n); }
+inline char* strcpy_P(char* a, const char* b) { return strcpy(a, b); }
+inline char* strcat_P(char* a, const char* b) { return strcat(a, b); }
+inline size_t strlen_P(const char* a) { return strlen(a); }
+inline void* memcpy_P(void* a, const void* b, size_t n) { return memcpy(a, b, n); }
+inline size_t strlcpy(char* d, const char* s, size_t n) {
+  size_t l = strlen(s);
+  if (n) {
+    size_t c = l < n - 1 ? l : n - 1;
+    memcpy(d, s, c);
+    d[c] = '\0';
+  }
+  return l;
+}
+inline size_t strlcpy_P(char* d, const char* s, size_t n) { return strlcpy(d, s, n); }
+
+template <typename T>
+inline char* _toa(T value, char* str) {
+  char digits[24];
+  uint8_t count = 0;
+  bool negative = value < 0;
+  do {
+    int digit = value % 10;
+    digits[count++] = '0' + (digit < 0 ? -digit : digit);
+    value /= 10;
+  } while (value != 0);
+  char* c = str;
+  if (negative) *c++ = '-';
+  while (count > 0) *c++ = digits[--count];
+  *c = '\0';
+  return str;
+}
+inline char* itoa(int v, char* s, int) { return _toa(v, s); }
+inline char* ltoa(long v, char* s, int) { return _toa(v, s); }
+inline char* utoa(unsigned v, char* s, int) { return _toa(v, s); }
+inline char* ultoa(unsigned long v, char* s, int) { return _toa(v, s); }
+inline char* dtostrf(double v, signed char w, unsigned char p, char* s) { sprintf(s, "%*.*f", w, p, v); return s; }
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+class String {
+ public:
+  String(const char* s = "") { _assign(s, strlen(s)); }
+  String(const String& s) { _assign(s._buffer, s._length); }
+  String(const __FlashStringHelper* s) { const char* p = reinterpret_cast<const char*>(s); _assign(p, strlen(p)); }
+  explicit String(char c) { _assign(&c, 1); }
+  explicit String(int v, unsigned char = 10) { char b[12]; _assign(b, sprintf(b, "%d", v)); }
+  explicit String(unsigned int v, unsigned char = 10) { char b[11]; _assign(b, sprintf(b, "%u", v)); }
+  explicit String(long v, unsigned char = 10) { char b[21]; _assign(b, sprintf(b, "%ld", v)); }
+  explicit String(unsigned long v, unsigned char = 10) { char b[21]; _assign(b, sprintf(b, "%lu", v)); }
+  explicit String(float v, unsigned char p = 2) : String(static_cast<double>(v), p) {}
+  explicit String(double v, unsigned char p = 2) { char b[64]; _assign(b, snprintf(b, sizeof(b), "%.*f", p, v)); }
+  ~String() { delete[] _buffer; }
+
+  String& operator=(const String& s) { if (this != &s) { delete[] _buffer; _assign(s._buffer, s._length); } return *this; }
+  String& operator=(const char* s) { String copy(s); return *this = copy; }
+  bool concat(const String& s) { return _append(s._buffer, s._length); }
+  bool concat(const char* s) { return _append(s, strlen(s)); }
+  bool concat(const __FlashStringHelper* s) { return concat(reinterpret_cast<const char*>(s)); }
+  bool concat(char c) { return _append(&c, 1); }
+  bool concat(int v) { return concat(String(v)); }
+  bool concat(unsigned int v) { return concat(String(v)); }
+  bool concat(long v) { return concat(String(v)); }
+  bool concat(unsigned long v) { return concat(String(v)); }
+  bool concat(float v) { return concat(String(v)); }
+  bool concat(double v) { return concat(String(v)); }
+  String& operator+=(const String& s) { concat(s); return *this; }
+  String& operator+=(const char* s) { concat(s); return *this; }
+  String& operator+=(char c) { concat(c); return *this; }
+
+  const char* c_str() const { return _buffer; }
+  unsigned int length() const { return _length; }
+  char charAt(unsigned int i) const { return i < _length ? _buffer[i] : '\0'; }
+  char operator[](unsigned int i) const { return charAt(i); }
+  long toInt() const { return atol(_buffer); }
+  float toFloat() const { return atof(_buffer); }
+  void remove(unsigned int index) { if (index < _length) { _length = index; _buffer[index] = '\0'; } }
+  void remove(unsigned int index, unsigned int count) {
+    if (index >= _length) return;
+    if (count > _length - index) count = _length - index;
+    memmove(_buffer + index, _buffer + index + count, _length - index - count + 1);
+    _length -= count;
+  }
+  bool reserve(unsigned int) { return true; }
+  bool equals(const String& s) const { return _length == s._length && strcmp(_buffer, s._buffer) == 0; }
+  bool equals(const char* s) const { return strcmp(_buffer, s) == 0; }
+  bool operator==(const String& s) const { return equals(s); }
+  bool operator==(const char* s) const { return equals(s); }
+  bool operator!=(const char* s) const { return !equals(s); }
+  int indexOf(char c) const { const char* p = strchr(_buffer, c); return p ? p - _buffer : -1; }
+  String substring(unsigned int from, unsigned int to) const {
+    if (to > _length) to = _length;
+    if (from > to) from = to;
+    String result;
+    result._append(_buffer + from, to - from);
+    return result;
+  }
+  String substring(unsigned int from) const { return substring(from, _length); }
+
+ private:
+  void _assign(const char* s, size_t length) {
+    _buffer = new char[length + 1];
+    memcpy(_buffer, s, length);
+    _buffer[length] = '\0';
+    _length = length;
+  }
+  bool _append(const char* s, size_t length) {
+    char* buffer = new char[_length + length + 1];
+    memcpy(buffer, _buffer, _length);
+    memcpy(buffer + _length, s, length);
+    buffer[_length + length] = '\0';
+    delete[] _buffer;
+    _buffer = buffer;
+    _length += length;
+    return true;
+  }
+
+  char* _buffer;
+  size_t _length;
+};
+
+inline String operator+(const String& a, const String& b) { String result(a); result.concat(b); return result; }
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    size_t written = 0;
+    while (size--) written += write(*buffer++);
+    return written;
+  }
+  size_t write(const char* s) { return write(reinterpret_cast<const uint8_t*>(s), strlen(s)); }
+  size_t print(const __FlashStringHelper* s) { return write(reinterpret_cast<const char*>(s)); }
+  size_t print(const String& s) { return write(s.c_str()); }
+  size_t print(const char* s) { return write(s); }
+  size_t print(char c) { return write(static_cast<uint8_t>(c)); }
+  size_t print(unsigned char v, int = 10) { return print(String(static_cast<unsigned int>(v))); }
+  size_t print(int v, int = 10) { return print(String(v)); }
+  size_t print(unsigned int v, int = 10) { return print(String(v)); }
+  size_t print(long v, int = 10) { return print(String(v)); }
+  size_t print(unsigned long v, int = 10) { return print(String(v)); }
+  size_t print(long long v, int = 10) { return print(String(static_cast<long>(v))); }
+  size_t print(unsigned long long v, int = 10) { return print(String(static_cast<unsigned long>(v))); }
+  size_t print(double v, int p = 2) { return print(String(v, p)); }
+  size_t println() { return write("\r\n"); }
+  size_t printf(const char*, ...) { return 0; }
+};
+
+class Stream : public Print {
+ public:
+  virtual int available() { return 0; }
+  virtual int read() { return -1; }
+  size_t readBytes(char* buffer, size_t length) {
+    size_t count = 0;
+    while (count < length && available() > 0) buffer[count++] = read();
+    return count;
+  }
+  long parseInt() { return 0; }
+};
+
+class HardwareSerial : public Stream {
+ public:
+  using Print::write;
+  size_t write(uint8_t) { return 1; }  // logs are discarded
+  void begin(unsigned long) {}
+  void flush() {}
+};
+extern HardwareSerial Serial;
+
+enum RFMode { RF_DEFAULT = 0 };
+
+class EspClass {
+ public:
+  bool rtcUserMemoryRead(uint32_t offset, uint32_t* data, size_t size);
+  bool rtcUserMemoryWrite(uint32_t offset, uint32_t* data, size_t size);
+  String getSketchMD5() { return String("d41d8cd98f00b204e9800998ecf8427e"); }
+  void restart() {}
+  void deepSleep(uint32_t, RFMode = RF_DEFAULT) {}
+  uint32_t getFreeHeap() { return 40000; }
+  uint32_t getChipId() { return 0x00abcdef; }
+};
+extern EspClass ESP;
+
+#define UPDATE_ERROR_OK 0
+#define UPDATE_ERROR_WRITE 1
+#define UPDATE_ERROR_ERASE 2
+#define UPDATE_ERROR_READ 3
+#define UPDATE_ERROR_SPACE 4
+#define UPDATE_ERROR_SIZE 5
+#define UPDATE_ERROR_STREAM 6
+#define UPDATE_ERROR_MD5 7
+#define UPDATE_ERROR_FLASH_CONFIG 8
+#define UPDATE_ERROR_NEW_FLASH_CONFIG 9
+#define UPDATE_ERROR_MAGIC_BYTE 10
+
+class UpdaterClass {
+ public:
+  void runAsync(bool) {}
+  bool setMD5(const char*) { return true; }
+  bool begin(size_t) { return false; }
+  size_t write(uint8_t*, size_t) { return 0; }
+  bool end(bool = false) { return false; }
+  uint8_t getError() { return UPDATE_ERROR_SPACE; }
+};
+extern UpdaterClass Update;
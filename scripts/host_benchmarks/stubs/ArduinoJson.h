@@ -0,0 +1,89 @@
+#pragma once
+
+// Parses nothing: the configuration is filled in directly by the benchmarks
+
+#include "Arduino.h"
+
+#define JSON_OBJECT_SIZE(n) (16 * (n))
+#define JSON_ARRAY_SIZE(n) (16 * (n))
+
+class JsonObject;
+class JsonArray;
+
+template <typename T>
+struct JsonDefault {
+  static T get() { return T(); }
+};
+
+class JsonVariant {
+ public:
+  JsonVariant() {}
+  template <typename T> JsonVariant(const T&) {}
+  template <typename T> T as() const { return JsonDefault<T>::get(); }
+  template <typename T> bool is() const { return false; }
+  template <typename T> operator T() const { return JsonDefault<T>::get(); }
+  template <typename K> JsonVariant operator[](const K&) const { return JsonVariant(); }
+  template <typename T> JsonVariant& operator=(const T&) { return *this; }
+  bool success() const { return false; }
+};
+
+struct JsonPair {
+  const char* key;
+  JsonVariant value;
+};
+
+class JsonObject {
+ public:
+  typedef JsonPair* iterator;
+  iterator begin() { return nullptr; }
+  iterator end() { return nullptr; }
+  bool success() const { return false; }
+  template <typename K> JsonVariant operator[](const K&) const { return JsonVariant(); }
+  template <typename T, typename K> T get(const K&) const { return T(); }
+  template <typename K> bool containsKey(const K&) const { return false; }
+  template <typename K> void remove(const K&) {}
+  template <typename K, typename V> bool set(const K&, const V&) { return false; }
+  JsonObject& createNestedObject(const char*) { return invalid(); }
+  JsonArray& createNestedArray(const char*);
+  size_t size() const { return 0; }
+  size_t measureLength() const { return 2; }
+  size_t printTo(char* buffer, size_t size) const { return strlcpy(buffer, "{}", size); }
+  size_t printTo(Print& print) const { return print.print("{}"); }
+  size_t printTo(String& string) const { string = "{}"; return 2; }
+  static JsonObject& invalid() { static JsonObject object; return object; }
+};
+
+class JsonArray {
+ public:
+  template <typename T> bool add(const T&) { return false; }
+  JsonObject& createNestedObject() { return JsonObject::invalid(); }
+  size_t printTo(String& string) const { string = "[]"; return 2; }
+  static JsonArray& invalid() { static JsonArray array; return array; }
+};
+
+inline JsonArray& JsonObject::createNestedArray(const char*) { return JsonArray::invalid(); }
+
+template <>
+struct JsonDefault<JsonObject&> {
+  static JsonObject& get() { return JsonObject::invalid(); }
+};
+
+template <>
+struct JsonDefault<JsonArray&> {
+  static JsonArray& get() { return JsonArray::invalid(); }
+};
+
+class JsonBuffer {
+ public:
+  JsonObject& parseObject(const char*) { return JsonObject::invalid(); }
+  JsonObject& parseObject(char*) { return JsonObject::invalid(); }
+  JsonObject& createObject() { return JsonObject::invalid(); }
+  JsonArray& createArray() { return JsonArray::invalid(); }
+};
+
+template <size_t N> class StaticJsonBuffer : public JsonBuffer {};
+
+class DynamicJsonBuffer : public JsonBuffer {
+ public:
+  explicit DynamicJsonBuffer(size_t = 0) {}
+};
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <functional>
+#include "Arduino.h"
+
+enum class AsyncMqttClientDisconnectReason : int8_t { TCP_DISCONNECTED = 0 };
+struct AsyncMqttClientMessageProperties { uint8_t qos; bool dup; bool retain; };
+
+// Keeps the callbacks so that the benchmarks can deliver messages and acknowledgments themselves
+class AsyncMqttClient {
+ public:
+  typedef std::function<void(bool sessionPresent)> OnConnectUserCallback;
+  typedef std::function<void(AsyncMqttClientDisconnectReason reason)> OnDisconnectUserCallback;
+  typedef std::function<void(char* topic, char* payload, AsyncMqttClientMessageProperties properties, size_t len, size_t index, size_t total)> OnMessageUserCallback;
+  typedef std::function<void(uint16_t packetId)> OnPublishUserCallback;
+  typedef std::function<void(uint16_t packetId, uint8_t qos)> OnSubscribeUserCallback;
+
+  AsyncMqttClient& onConnect(OnConnectUserCallback callback) { connectCallback = callback; return *this; }
+  AsyncMqttClient& onDisconnect(OnDisconnectUserCallback callback) { disconnectCallback = callback; return *this; }
+  AsyncMqttClient& onMessage(OnMessageUserCallback callback) { messageCallback = callback; return *this; }
+  AsyncMqttClient& onPublish(OnPublishUserCallback callback) { publishCallback = callback; return *this; }
+  AsyncMqttClient& onSubscribe(OnSubscribeUserCallback callback) { subscribeCallback = callback; return *this; }
+  AsyncMqttClient& setServer(const char*, uint16_t) { return *this; }
+  AsyncMqttClient& setMaxTopicLength(uint16_t) { return *this; }
+  AsyncMqttClient& setClientId(const char*) { return *this; }
+  AsyncMqttClient& setCleanSession(bool) { return *this; }
+  AsyncMqttClient& setKeepAlive(uint16_t) { return *this; }
+  AsyncMqttClient& setWill(const char*, uint8_t, bool, const char* = nullptr, size_t = 0) { return *this; }
+  AsyncMqttClient& setCredentials(const char*, const char* = nullptr) { return *this; }
+  bool connected() const { return isConnected; }
+  void connect() {}
+  void disconnect(bool = false) {}
+  uint16_t subscribe(const char*, uint8_t qos) { return _nextPacketId(); }
+  uint16_t unsubscribe(const char*) { return _nextPacketId(); }
+  uint16_t publish(const char* topic, uint8_t qos, bool retain, const char* payload = nullptr, size_t length = 0, bool = false, uint16_t = 0) {
+    if (!acceptPublishes) return 0;
+    publishCount++;
+    if (payload && length == 0) length = strlen(payload);  // like the real client
+    uint16_t packetId = qos == 0 ? 1 : _nextPacketId();
+    if (publishObserver) publishObserver(topic, payload, length, packetId);
+    return packetId;
+  }
+
+  bool isConnected = false;
+  bool acceptPublishes = true;  // false simulates a full TCP buffer
+  uint32_t publishCount = 0;
+  std::function<void(const char* topic, const char* payload, size_t length, uint16_t packetId)> publishObserver;
+  OnConnectUserCallback connectCallback;
+  OnDisconnectUserCallback disconnectCallback;
+  OnMessageUserCallback messageCallback;
+  OnPublishUserCallback publishCallback;
+  OnSubscribeUserCallback subscribeCallback;
+
+ private:
+  uint16_t _nextPacketId() {
+    if (++_packetId == 0) _packetId = 1;
+    return _packetId;
+  }
+
+  uint16_t _packetId = 0;
+};
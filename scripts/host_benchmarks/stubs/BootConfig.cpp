@@ -0,0 +1,21 @@
+#include "Homie/Boot/BootConfig.hpp"
+
+// Stands in for src/Homie/Boot/BootConfig.cpp: configuration mode needs the web server, which is not simulated
+
+using namespace HomieInternals;
+
+BootConfig::BootConfig()
+: Boot("config")
+, _http(80) {
+}
+
+BootConfig::~BootConfig() {
+}
+
+void BootConfig::setup() {
+  Boot::setup();
+}
+
+void BootConfig::loop() {
+  Boot::loop();
+}
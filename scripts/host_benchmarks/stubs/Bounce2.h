@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Arduino.h"
+
+class Bounce {
+ public:
+  void attach(int) {}
+  void interval(uint16_t) {}
+  bool update() { return false; }
+  int read() { return HIGH; }
+};
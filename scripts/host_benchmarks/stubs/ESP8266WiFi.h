@@ -0,0 +1,33 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include "Arduino.h"
+#include "IPAddress.h"
+
+enum WiFiDisconnectReason { WIFI_DISCONNECT_REASON_UNSPECIFIED = 1 };
+enum WiFiMode_t { WIFI_OFF, WIFI_STA, WIFI_AP, WIFI_AP_STA };
+struct WiFiEventStationModeGotIP { IPAddress ip; IPAddress mask; IPAddress gw; };
+struct WiFiEventStationModeDisconnected { String ssid; WiFiDisconnectReason reason; };
+struct WiFiEventHandlerOpaque {};
+typedef std::shared_ptr<WiFiEventHandlerOpaque> WiFiEventHandler;
+
+// never connects, the benchmarks drive the MQTT callbacks directly
+class ESP8266WiFiClass {
+ public:
+  WiFiEventHandler onStationModeGotIP(std::function<void(const WiFiEventStationModeGotIP&)>) { return WiFiEventHandler(); }
+  WiFiEventHandler onStationModeDisconnected(std::function<void(const WiFiEventStationModeDisconnected&)>) { return WiFiEventHandler(); }
+  WiFiMode_t getMode() { return WIFI_STA; }
+  bool mode(WiFiMode_t) { return true; }
+  bool hostname(const char*) { return true; }
+  bool config(IPAddress, IPAddress, IPAddress, IPAddress = IPAddress(), IPAddress = IPAddress()) { return true; }
+  int begin(const char*, const char* = nullptr, int32_t = 0, const uint8_t* = nullptr, bool = true) { return 0; }
+  void persistent(bool) {}
+  uint8_t* macAddress(uint8_t* mac) { memset(mac, 0, 6); return mac; }
+  String macAddress() { return String("00:00:00:00:00:00"); }
+  bool setAutoConnect(bool) { return true; }
+  bool setAutoReconnect(bool) { return true; }
+  int32_t RSSI() { return -60; }
+  IPAddress localIP() { return IPAddress(192, 168, 0, 2); }
+};
+extern ESP8266WiFiClass WiFi;
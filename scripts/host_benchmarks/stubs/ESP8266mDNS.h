@@ -0,0 +1,7 @@
+#pragma once
+
+class MDNSResponder {
+ public:
+  bool begin(const char*) { return true; }
+};
+extern MDNSResponder MDNS;
@@ -0,0 +1,8 @@
+#pragma once
+
+// configuration mode is not simulated, see BootConfig.cpp
+class AsyncWebServerRequest;
+class AsyncWebServer {
+ public:
+  explicit AsyncWebServer(int) {}
+};
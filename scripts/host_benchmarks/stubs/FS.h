@@ -0,0 +1,65 @@
+#pragma once
+
+// In-memory SPIFFS: files are byte vectors, and every open, write and byte written is counted
+
+#include <map>
+#include <string>
+#include "Arduino.h"
+
+class File : public Stream {
+ public:
+  File() : _data(nullptr), _position(0), _writable(false) {}
+  File(std::vector<uint8_t>* data, bool writable) : _data(data), _position(0), _writable(writable) {}
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t* buffer, size_t size) override;
+  size_t read(uint8_t* buffer, size_t size) {
+    if (!_data || _position >= _data->size()) return 0;
+    if (size > _data->size() - _position) size = _data->size() - _position;
+    memcpy(buffer, _data->data() + _position, size);
+    _position += size;
+    return size;
+  }
+  int available() override { return _data ? static_cast<int>(_data->size() - _position) : 0; }
+  int read() override { uint8_t c; return read(&c, 1) == 1 ? c : -1; }
+  size_t size() const { return _data ? _data->size() : 0; }
+  bool seek(uint32_t position) { if (!_data || position > _data->size()) return false; _position = position; return true; }
+  size_t position() const { return _position; }
+  void flush() {}
+  void close() { _data = nullptr; }
+  operator bool() const { return _data != nullptr; }
+
+ private:
+  std::vector<uint8_t>* _data;
+  size_t _position;
+  bool _writable;
+};
+
+class FS {
+ public:
+  struct Stats {
+    uint32_t opens;
+    uint32_t writes;
+    uint64_t bytesWritten;
+  };
+
+  bool begin() { return true; }
+  bool exists(const char* path) { return _files.count(path) > 0; }
+  File open(const char* path, const char* mode);
+  bool remove(const char* path) { return _files.erase(path) > 0; }
+  bool rename(const char* from, const char* to) {
+    auto it = _files.find(from);
+    if (it == _files.end()) return false;
+    _files[to] = it->second;
+    _files.erase(from);
+    return true;
+  }
+
+  void format() { _files.clear(); }
+  Stats& getStats() { return _stats; }
+
+ private:
+  std::map<std::string, std::vector<uint8_t>> _files;
+  Stats _stats = {};
+};
+extern FS SPIFFS;
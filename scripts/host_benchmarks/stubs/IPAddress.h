@@ -0,0 +1,21 @@
+#pragma once
+
+#include "Arduino.h"
+
+class IPAddress {
+ public:
+  IPAddress() : _bytes{ 0, 0, 0, 0 } {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _bytes{ a, b, c, d } {}
+  bool fromString(const char* str) {
+    unsigned int a, b, c, d;
+    if (sscanf(str, "%u.%u.%u.%u", &a, &b, &c, &d) != 4 || a > 255 || b > 255 || c > 255 || d > 255) return false;
+    *this = IPAddress(a, b, c, d);
+    return true;
+  }
+  uint8_t operator[](int index) const { return _bytes[index]; }
+  String toString() const { char str[16]; sprintf(str, "%u.%u.%u.%u", _bytes[0], _bytes[1], _bytes[2], _bytes[3]); return String(str); }
+  operator uint32_t() const { return _bytes[0] | _bytes[1] << 8 | _bytes[2] << 16 | static_cast<uint32_t>(_bytes[3]) << 24; }
+
+ private:
+  uint8_t _bytes[4];
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stdint.h>
+#include <functional>
+
+// never fires
+class Ticker {
+ public:
+  void attach(float, std::function<void()>) {}
+  template <typename T> void attach(float, void (*)(T), T) {}
+  void attach_ms(uint32_t, std::function<void()>) {}
+  void once(float, std::function<void()>) {}
+  void detach() {}
+};
@@ -0,0 +1,51 @@
+#include "Arduino.h"
+#include "ESP8266WiFi.h"
+#include "ESP8266mDNS.h"
+#include "FS.h"
+
+uint64_t Host::clockMicros = 0;
+
+HardwareSerial Serial;
+EspClass ESP;
+UpdaterClass Update;
+ESP8266WiFiClass WiFi;
+MDNSResponder MDNS;
+FS SPIFFS;
+
+static uint32_t rtcUserMemory[128];
+
+bool EspClass::rtcUserMemoryRead(uint32_t offset, uint32_t* data, size_t size) {
+  if (offset * 4 + size > sizeof(rtcUserMemory)) return false;
+  memcpy(data, rtcUserMemory + offset, size);
+  return true;
+}
+
+bool EspClass::rtcUserMemoryWrite(uint32_t offset, uint32_t* data, size_t size) {
+  if (offset * 4 + size > sizeof(rtcUserMemory)) return false;
+  memcpy(rtcUserMemory + offset, data, size);
+  return true;
+}
+
+size_t File::write(const uint8_t* buffer, size_t size) {
+  if (!_data || !_writable) return 0;
+  if (_position + size > _data->size()) _data->resize(_position + size);
+  memcpy(_data->data() + _position, buffer, size);
+  _position += size;
+
+  SPIFFS.getStats().writes++;
+  SPIFFS.getStats().bytesWritten += size;
+  return size;
+}
+
+File FS::open(const char* path, const char* mode) {
+  bool exists = _files.count(path) > 0;
+  if (mode[0] == 'r' && !exists) return File();
+
+  _stats.opens++;
+  std::vector<uint8_t>* data = &_files[path];
+  if (mode[0] == 'w') data->clear();
+
+  File file(data, mode[0] != 'r' || mode[1] == '+');
+  if (mode[0] == 'a') file.seek(data->size());
+  return file;
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <stddef.h>
+
+typedef struct { int step; char plainchar; } base64_decodestate;
+inline void base64_init_decodestate(base64_decodestate* state) { state->step = 0; state->plainchar = 0; }
+inline int base64_decode_block(const char*, const int, char*, base64_decodestate*) { return 0; }
+inline size_t base64_decode_expected_len(size_t n) { return n * 3 / 4; }
@@ -18,19 +18,24 @@ HomieClass::HomieClass()
   Interface::get().reset.triggerState = DEFAULT_RESET_STATE;
   Interface::get().reset.triggerTime = DEFAULT_RESET_TIME;
   Interface::get().reset.resetFlag = false;
+  Interface::get().inbound.maxPayloadSize = DEFAULT_MAX_INPUT_PAYLOAD_SIZE;
   Interface::get().disable = false;
   Interface::get().flaggedForSleep = false;
-  Interface::get().globalInputHandler = [](const HomieNode& node, const String& property, const HomieRange& range, const String& value) { return false; };
+  Interface::get().globalInputHandler = [](const HomieNode& node, const HomieStringView& property, const HomieRange& range, const HomieStringView& value) { return false; };
   Interface::get().broadcastHandler = [](const String& level, const String& value) { return false; };
   Interface::get().setupFunction = []() {};
   Interface::get().loopFunction = []() {};
   Interface::get().eventHandler = [](const HomieEvent& event) {};
   Interface::get().ready = false;
   Interface::get()._mqttClient = &_mqttClient;
-  Interface::get()._sendingPromise = &_sendingPromise;
   Interface::get()._blinker = &_blinker;
   Interface::get()._logger = &_logger;
   Interface::get()._config = &_config;
+  Interface::get()._latency = &_latency;
+  Interface::get()._outboundQueue = &_outboundQueue;
+  Interface::get()._spool = &_spool;
+  Interface::get()._publishTracker = &_publishTracker;
+  Interface::get()._rateLimiter = &_rateLimiter;
 
   DeviceId::generate();
 }
@@ -49,6 +54,7 @@ void HomieClass::_checkBeforeSetup(const __FlashStringHelper* functionName) cons
 }
 
 void HomieClass::setup() {
+  Interface::get().setupStartedAt = millis();
   _setupCalled = true;
 
   // Check if firmware is set
@@ -245,6 +251,16 @@ void HomieClass::setIdle(bool idle) {
 HomieClass& HomieClass::setGlobalInputHandler(const GlobalInputHandler& globalInputHandler) {
   _checkBeforeSetup(F("setGlobalInputHandler"));
 
+  Interface::get().globalInputHandler = [globalInputHandler](const HomieNode& node, const HomieStringView& property, const HomieRange& range, const HomieStringView& value) {
+    return globalInputHandler(node, String(property.data), range, String(value.data));
+  };
+
+  return *this;
+}
+
+HomieClass& HomieClass::setGlobalInputHandler(const GlobalInputViewHandler& globalInputHandler) {
+  _checkBeforeSetup(F("setGlobalInputHandler"));
+
   Interface::get().globalInputHandler = globalInputHandler;
 
   return *this;
@@ -258,6 +274,108 @@ HomieClass& HomieClass::setBroadcastHandler(const BroadcastHandler& broadcastHan
   return *this;
 }
 
+HomieClass& HomieClass::subscribeBroadcast(const char* level, const BroadcastHandler& broadcastHandler, uint8_t qos) {
+  _checkBeforeSetup(F("subscribeBroadcast"));
+
+  if (level[0] == '\0' || strpbrk(level, "/+#") != nullptr) {
+    String message;
+    message.concat(F("✖ subscribeBroadcast(): invalid level "));
+    message.concat(level);
+    Helpers::abort(message);
+    return *this;  // never reached, here for clarity
+  }
+
+  for (const InterfaceData::BroadcastSubscription& iSubscription : Interface::get().broadcastSubscriptions) {
+    if (strcmp(iSubscription.level, level) == 0) {
+      String message;
+      message.concat(F("✖ subscribeBroadcast(): level already subscribed "));
+      message.concat(level);
+      Helpers::abort(message);
+      return *this;  // never reached, here for clarity
+    }
+  }
+
+  InterfaceData::BroadcastSubscription subscription;
+  subscription.level = strdup(level);  // the caller's string might be a temporary
+  subscription.handler = broadcastHandler;
+  subscription.qos = qos;
+  Interface::get().broadcastSubscriptions.push_back(subscription);
+
+  return *this;
+}
+
+HomieClass& HomieClass::setMaxInputPayloadSize(size_t size) {
+  _checkBeforeSetup(F("setMaxInputPayloadSize"));
+
+  Interface::get().inbound.maxPayloadSize = size;
+
+  return *this;
+}
+
+HomieClass& HomieClass::setInputQueue(uint8_t size, HomieInputQueuePolicy policy) {
+  _checkBeforeSetup(F("setInputQueue"));
+
+  Interface::get().inbound.queueSize = size;
+  Interface::get().inbound.queuePolicy = policy;
+
+  return *this;
+}
+
+HomieClass& HomieClass::setOfflineQueue(uint8_t size, bool latestPerTopic) {
+  _checkBeforeSetup(F("setOfflineQueue"));
+
+  Interface::get().offlineQueue.size = size;
+  Interface::get().offlineQueue.latestPerTopic = latestPerTopic;
+
+  return *this;
+}
+
+HomieClass& HomieClass::setSpool(uint16_t capacity, uint16_t replayRate) {
+  _checkBeforeSetup(F("setSpool"));
+
+  Interface::get().offlineQueue.spoolCapacity = capacity;
+  Interface::get().offlineQueue.spoolReplayRate = replayRate;
+
+  return *this;
+}
+
+HomieClass& HomieClass::setRateLimit(float rate, uint16_t burst, HomieRateLimitPolicy policy) {
+  _checkBeforeSetup(F("setRateLimit"));
+
+  Interface::get().rateLimit.rate = rate;
+  Interface::get().rateLimit.burst = burst;
+  Interface::get().rateLimit.policy = policy;
+
+  return *this;
+}
+
+HomieClass& HomieClass::setAdvertisementWindow(uint8_t window) {
+  _checkBeforeSetup(F("setAdvertisementWindow"));
+
+  if (window < 1 || window > MAX_ADVERTISEMENT_WINDOW) {
+    Helpers::abort(F("✖ setAdvertisementWindow(): the window must be between 1 and 16"));
+    return *this;  // never reached, here for clarity
+  }
+
+  Interface::get().advertisement.window = window;
+
+  return *this;
+}
+
+HomieClass& HomieClass::skipUnchangedAdvertisement(bool skip, int16_t rtcOffset) {
+  _checkBeforeSetup(F("skipUnchangedAdvertisement"));
+
+  if (rtcOffset < -1 || rtcOffset > MAX_ADVERTISEMENT_RTC_OFFSET) {
+    Helpers::abort(F("✖ skipUnchangedAdvertisement(): the RTC offset must be between 0 and 125, or -1"));
+    return *this;  // never reached, here for clarity
+  }
+
+  Interface::get().advertisement.skipUnchanged = skip;
+  Interface::get().advertisement.rtcOffset = rtcOffset;
+
+  return *this;
+}
+
 HomieClass& HomieClass::setSetupFunction(const OperationFunction& function) {
   _checkBeforeSetup(F("setSetupFunction"));
 
@@ -293,6 +411,18 @@ bool HomieClass::isConnected() {
   return Interface::get().ready;
 }
 
+bool HomieClass::canPublish(size_t length) {
+  return Interface::get().getPublishTracker().canPublish(length);
+}
+
+size_t HomieClass::getOutboundBytesInFlight() {
+  return Interface::get().getPublishTracker().getBytesInFlight();
+}
+
+uint8_t HomieClass::getOutboundMessagesInFlight() {
+  return Interface::get().getPublishTracker().getInFlightCount();
+}
+
 HomieClass& HomieClass::onEvent(const EventHandler& handler) {
   _checkBeforeSetup(F("onEvent"));
 
@@ -301,6 +431,14 @@ HomieClass& HomieClass::onEvent(const EventHandler& handler) {
   return *this;
 }
 
+HomieClass& HomieClass::onWritable(const OperationFunction& handler) {
+  _checkBeforeSetup(F("onWritable"));
+
+  Interface::get().writableHandler = handler;
+
+  return *this;
+}
+
 HomieClass& HomieClass::setResetTrigger(uint8_t pin, uint8_t state, uint16_t time) {
   _checkBeforeSetup(F("setResetTrigger"));
 
@@ -334,6 +472,7 @@ Logger& HomieClass::getLogger() {
 
 void HomieClass::prepareToSleep() {
   Interface::get().getLogger() << F("Flagged for sleep by sketch") << endl;
+  Interface::get().getSpool().flush();
   if (Interface::get().ready) {
     Interface::get().disable = true;
     Interface::get().flaggedForSleep = true;
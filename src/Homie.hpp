@@ -18,8 +18,12 @@
 #include "SendingPromise.hpp"
 #include "HomieBootMode.hpp"
 #include "HomieEvent.hpp"
+#include "HomieInputQueuePolicy.hpp"
+#include "HomieRateLimitPolicy.hpp"
 #include "HomieNode.hpp"
+#include "HomieRangeTable.hpp"
 #include "HomieSetting.hpp"
+#include "HomieStringView.hpp"
 #include "StreamingOperator.hpp"
 
 // Define DEBUG for debug
@@ -47,8 +51,18 @@ class HomieClass {
   HomieClass& setLedPin(uint8_t pin, uint8_t on);
   HomieClass& setConfigurationApPassword(const char* password);
   HomieClass& setGlobalInputHandler(const GlobalInputHandler& globalInputHandler);
+  HomieClass& setGlobalInputHandler(const GlobalInputViewHandler& globalInputHandler);
   HomieClass& setBroadcastHandler(const BroadcastHandler& broadcastHandler);
+  HomieClass& subscribeBroadcast(const char* level, const BroadcastHandler& broadcastHandler, uint8_t qos = 2);
+  HomieClass& setMaxInputPayloadSize(size_t size);
+  HomieClass& setInputQueue(uint8_t size, HomieInputQueuePolicy policy = HomieInputQueuePolicy::DROP_OLDEST);
+  HomieClass& setOfflineQueue(uint8_t size, bool latestPerTopic = true);
+  HomieClass& setSpool(uint16_t capacity, uint16_t replayRate = DEFAULT_SPOOL_REPLAY_RATE);
+  HomieClass& setRateLimit(float rate, uint16_t burst = 1, HomieRateLimitPolicy policy = HomieRateLimitPolicy::DROP);
+  HomieClass& setAdvertisementWindow(uint8_t window);
+  HomieClass& skipUnchangedAdvertisement(bool skip = true, int16_t rtcOffset = HomieInternals::DEFAULT_ADVERTISEMENT_RTC_OFFSET);
   HomieClass& onEvent(const EventHandler& handler);
+  HomieClass& onWritable(const OperationFunction& handler);
   HomieClass& setResetTrigger(uint8_t pin, uint8_t state, uint16_t time);
   HomieClass& disableResetTrigger();
   HomieClass& setSetupFunction(const OperationFunction& function);
@@ -61,6 +75,9 @@ class HomieClass {
   static void setIdle(bool idle);
   static bool isConfigured();
   static bool isConnected();
+  static bool canPublish(size_t length);
+  static size_t getOutboundBytesInFlight();
+  static uint8_t getOutboundMessagesInFlight();
   static const ConfigStruct& getConfiguration();
   AsyncMqttClient& getMqttClient();
   Logger& getLogger();
@@ -75,10 +92,14 @@ class HomieClass {
   BootNormal _bootNormal;
   BootConfig _bootConfig;
   bool _flaggedForReboot;
-  SendingPromise _sendingPromise;
   Logger _logger;
   Blinker _blinker;
   Config _config;
+  Latency _latency;
+  OutboundQueue _outboundQueue;
+  Spool _spool;
+  PublishTracker _publishTracker;
+  RateLimiter _rateLimiter;
   AsyncMqttClient _mqttClient;
 
   void _checkBeforeSetup(const __FlashStringHelper* functionName) const;
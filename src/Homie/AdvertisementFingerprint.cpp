@@ -0,0 +1,62 @@
+#include "AdvertisementFingerprint.hpp"
+
+using namespace HomieInternals;
+
+AdvertisementFingerprint::AdvertisementFingerprint()
+: _hash(2166136261UL) {
+}
+
+void AdvertisementFingerprint::add(const char* value) {
+  // the null terminator is hashed too, so that "ab" then "c" differs from "a" then "bc"
+  do {
+    _hash ^= static_cast<uint8_t>(*value);
+    _hash *= 16777619UL;
+  } while (*value++ != '\0');
+}
+
+uint32_t AdvertisementFingerprint::get() const {
+  return _hash;
+}
+
+bool AdvertisementFingerprint::load(int16_t rtcOffset, uint32_t* fingerprint) {
+  Record record;
+  if (rtcOffset < 0) {
+    if (!_loadFromFlash(&record)) return false;
+  } else if (!ESP.rtcUserMemoryRead(rtcOffset, reinterpret_cast<uint32_t*>(&record), sizeof(record)) || !_isValid(record)) {
+    if (!_loadFromFlash(&record)) return false;
+    ESP.rtcUserMemoryWrite(rtcOffset, reinterpret_cast<uint32_t*>(&record), sizeof(record));
+  }
+
+  *fingerprint = record.fingerprint;
+  return true;
+}
+
+void AdvertisementFingerprint::save(int16_t rtcOffset, uint32_t fingerprint) {
+  Record record;
+  record.magic = ADVERTISEMENT_MAGIC;
+  record.fingerprint = fingerprint;
+  record.check = ~fingerprint;
+  if (rtcOffset >= 0) ESP.rtcUserMemoryWrite(rtcOffset, reinterpret_cast<uint32_t*>(&record), sizeof(record));
+
+  // spare the flash if it already holds it
+  Record flashRecord;
+  if (_loadFromFlash(&flashRecord) && flashRecord.fingerprint == fingerprint) return;
+
+  File fingerprintFile = SPIFFS.open(ADVERTISEMENT_FILE_PATH, "w");
+  if (!fingerprintFile) return;
+  fingerprintFile.write(reinterpret_cast<const uint8_t*>(&record), sizeof(record));
+  fingerprintFile.close();
+}
+
+bool AdvertisementFingerprint::_isValid(const Record& record) {
+  return record.magic == ADVERTISEMENT_MAGIC && record.check == ~record.fingerprint;
+}
+
+bool AdvertisementFingerprint::_loadFromFlash(Record* record) {
+  File fingerprintFile = SPIFFS.open(ADVERTISEMENT_FILE_PATH, "r");
+  if (!fingerprintFile) return false;
+  size_t read = fingerprintFile.read(reinterpret_cast<uint8_t*>(record), sizeof(Record));
+  fingerprintFile.close();
+
+  return read == sizeof(Record) && _isValid(*record);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Arduino.h"
+
+#include <FS.h>
+#include "Constants.hpp"
+
+namespace HomieInternals {
+// FNV-1a hash of the retained advertisement, persisted so that an unchanged advertisement can be skipped on reconnect
+class AdvertisementFingerprint {
+ public:
+  AdvertisementFingerprint();
+  void add(const char* value);
+  uint32_t get() const;
+
+  // rtcOffset in 4-byte blocks, -1 to leave the RTC memory alone
+  static bool load(int16_t rtcOffset, uint32_t* fingerprint);  // from RTC memory, or from flash after a power loss
+  static void save(int16_t rtcOffset, uint32_t fingerprint);
+
+ private:
+  struct Record {
+    uint32_t magic;
+    uint32_t fingerprint;
+    uint32_t check;  // ~fingerprint, RTC memory is random after a power loss
+  };
+
+  uint32_t _hash;
+
+  static bool _isValid(const Record& record);
+  static bool _loadFromFlash(Record* record);
+};
+}  // namespace HomieInternals
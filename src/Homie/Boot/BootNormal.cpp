@@ -2,8 +2,16 @@
 
 using namespace HomieInternals;
 
+const BootNormal::ImplementationRoute BootNormal::IMPLEMENTATION_ROUTES[] = {
+  { 5, "ota", "firmware", MqttRoute::OTA_FIRMWARE },  // <id>/$implementation/ota/firmware/<md5>
+  { 3, "reset", nullptr, MqttRoute::RESET },  // <id>/$implementation/reset
+  { 4, "config", "set", MqttRoute::CONFIG_SET }  // <id>/$implementation/config/set
+};
+const uint8_t BootNormal::IMPLEMENTATION_ROUTES_COUNT = sizeof(BootNormal::IMPLEMENTATION_ROUTES) / sizeof(BootNormal::ImplementationRoute);
+
 BootNormal::BootNormal()
   : Boot("normal")
+  , _statsStep(StatsStep::BEGIN)
   , _mqttReconnectTimer(MQTT_RECONNECT_INITIAL_INTERVAL, MQTT_RECONNECT_MAX_BACKOFF)
   , _setupFunctionCalled(false)
   , _mqttConnectNotified(false)
@@ -11,16 +19,33 @@ BootNormal::BootNormal()
   , _otaOngoing(false)
   , _flaggedForReboot(false)
   , _mqttOfflineMessageId(0)
+  , _connectionTimestamps{ .startedAt = 0, .wifiConnectAt = 0, .wifiConnectedAt = 0, .mqttConnectAt = 0, .mqttConnectedAt = 0 }
+  , _bootTiming{ .setup = 0, .wifi = 0, .mqtt = 0, .advertisement = 0, .total = 0 }
+  , _bootTimingPublished(true)
+  , _bootTimingStep(0)
+  , _advertisementFingerprint(0)
+  , _advertisedFingerprint(0)
+  , _advertisedFingerprintValid(false)
   , _otaIsBase64(false)
   , _otaBase64Pads(0)
   , _otaSizeTotal(0)
   , _otaSizeDone(0)
   , _mqttTopic(nullptr)
+  , _advertisementPayloads(nullptr)
+  , _propertiesPayloads(nullptr)
   , _mqttClientId(nullptr)
   , _mqttWillTopic(nullptr)
   , _mqttPayloadBuffer(nullptr)
+  , _mqttPayloadBufferSize(0)
+  , _mqttPayloadRejectedCount(0)
   , _mqttTopicLevels(nullptr)
-  , _mqttTopicLevelsCount(0) {
+  , _mqttTopicLevelsCapacity(0)
+  , _mqttTopicLevelsCount(0)
+  , _mqttRoute(MqttRoute::UNROUTED)
+  , _mqttRouteNode(nullptr)
+  , _mqttRouteProperty(nullptr)
+  , _mqttRouteRange{ .isRange = false, .index = 0 }
+  , _mqttMessageReceivedAt(0) {
   strlcpy(_fwChecksum, ESP.getSketchMD5().c_str(), sizeof(_fwChecksum));
   _fwChecksum[sizeof(_fwChecksum) - 1] = '\0';
 }
@@ -56,10 +81,11 @@ void BootNormal::setup() {
   _wifiGotIpHandler = WiFi.onStationModeGotIP(std::bind(&BootNormal::_onWifiGotIp, this, std::placeholders::_1));
   _wifiDisconnectedHandler = WiFi.onStationModeDisconnected(std::bind(&BootNormal::_onWifiDisconnected, this, std::placeholders::_1));
 
-  Interface::get().getMqttClient().onConnect(std::bind(&BootNormal::_onMqttConnected, this));
+  Interface::get().getMqttClient().onConnect(std::bind(&BootNormal::_onMqttConnected, this, std::placeholders::_1));
   Interface::get().getMqttClient().onDisconnect(std::bind(&BootNormal::_onMqttDisconnected, this, std::placeholders::_1));
   Interface::get().getMqttClient().onMessage(std::bind(&BootNormal::_onMqttMessage, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5, std::placeholders::_6));
   Interface::get().getMqttClient().onPublish(std::bind(&BootNormal::_onMqttPublish, this, std::placeholders::_1));
+  Interface::get().getMqttClient().onSubscribe(std::bind(&BootNormal::_onMqttSubscribe, this, std::placeholders::_1, std::placeholders::_2));
 
   Interface::get().getMqttClient().setServer(Interface::get().getConfig().get().mqtt.server.host, Interface::get().getConfig().get().mqtt.server.port);
   Interface::get().getMqttClient().setMaxTopicLength(MAX_MQTT_TOPIC_LENGTH);
@@ -83,12 +109,32 @@ void BootNormal::setup() {
     iNode->setup();
   }
 
+  // nodes and properties are frozen from here
+  __buildRoutes();
+  _renderAdvertisementPayloads();
+  _inputQueue.setup(Interface::get().inbound.queueSize, Interface::get().inbound.queuePolicy);
+  Interface::get().getOutboundQueue().setup(Interface::get().offlineQueue.size, Interface::get().offlineQueue.latestPerTopic);
+  if (Interface::get().offlineQueue.spoolCapacity > 0) Interface::get().getSpool().setup(Interface::get().offlineQueue.spoolCapacity, Interface::get().offlineQueue.spoolReplayRate);
+  Interface::get().getRateLimiter().setup(Interface::get().rateLimit.rate, Interface::get().rateLimit.burst, Interface::get().rateLimit.policy);
+
+  if (Interface::get().advertisement.skipUnchanged) {
+    // the subscriptions must outlive the connection too
+    Interface::get().getMqttClient().setCleanSession(false);
+    _advertisementFingerprint = _computeAdvertisementFingerprint();
+    _advertisedFingerprintValid = AdvertisementFingerprint::load(Interface::get().advertisement.rtcOffset, &_advertisedFingerprint);
+  }
+
+  _bootTiming.setup = millis() - Interface::get().setupStartedAt;
+  _connectionTimestamps.startedAt = Interface::get().setupStartedAt;
   _wifiConnect();
 }
 
 void BootNormal::loop() {
   Boot::loop();
 
+  Interface::get().getSpool().loop();
+  Interface::get().getPublishTracker().loop();
+
   if (_flaggedForReboot && Interface::get().reset.idle) {
     Interface::get().getLogger() << F("Device is idle") << endl;
 
@@ -107,21 +153,42 @@ void BootNormal::loop() {
   // here, we are connected to the broker
 
   if (!_advertisementProgress.done) {
-    _advertise();
+    // as many steps as the window and the MQTT client buffer allow
+    while (!_advertisementProgress.done && _advertisementProgress.inFlightCount < Interface::get().advertisement.window && _advertise()) {}
     return;
   }
 
   // here, we finished the advertisement
 
+  if (Interface::get().advertisement.skipUnchanged && _advertisementProgress.inFlightCount == 0 && (!_advertisedFingerprintValid || _advertisedFingerprint != _advertisementFingerprint)) {
+    AdvertisementFingerprint::save(Interface::get().advertisement.rtcOffset, _advertisementFingerprint);
+    _advertisedFingerprint = _advertisementFingerprint;
+    _advertisedFingerprintValid = true;
+  }
+
   if (!_mqttConnectNotified) {
     Interface::get().ready = true;
     if (Interface::get().led.enabled) Interface::get().getBlinker().stop();
 
-    Interface::get().getLogger() << F("✔ MQTT ready") << endl;
+    uint32_t now = millis();
+    _bootTiming.wifi = _connectionTimestamps.wifiConnectAt != 0 ? _connectionTimestamps.wifiConnectedAt - _connectionTimestamps.wifiConnectAt : 0;
+    _bootTiming.mqtt = _connectionTimestamps.mqttConnectedAt - _connectionTimestamps.mqttConnectAt;
+    _bootTiming.advertisement = now - _connectionTimestamps.mqttConnectedAt;
+    _bootTiming.total = now - _connectionTimestamps.startedAt;
+    _connectionTimestamps = { .startedAt = 0, .wifiConnectAt = 0, .wifiConnectedAt = 0, .mqttConnectAt = 0, .mqttConnectedAt = 0 };
+    _bootTimingPublished = false;
+    _bootTimingStep = 0;
+
+    Interface::get().getLogger() << F("✔ MQTT ready in ") << _bootTiming.total << F("ms") << endl;
     Interface::get().getLogger() << F("Triggering MQTT_READY event...") << endl;
     Interface::get().event.type = HomieEventType::MQTT_READY;
     Interface::get().eventHandler(Interface::get().event);
 
+    Interface::get().getLogger() << F("Triggering BOOT_TIMING event...") << endl;
+    Interface::get().event.type = HomieEventType::BOOT_TIMING;
+    Interface::get().event.bootTiming = _bootTiming;
+    Interface::get().eventHandler(Interface::get().event);
+
     for (HomieNode* iNode : HomieNode::nodes) {
       iNode->onReadyToOperate();
     }
@@ -138,26 +205,34 @@ void BootNormal::loop() {
 
   // here, we have notified the sketch we are ready
 
+  if (!_bootTimingPublished) _bootTimingPublished = _publishBootTiming();
+
+  InputMessage message;
+  while (_inputQueue.pop(&message)) {
+    __handleInputMessage(message);
+  }
+
+  // spooled publishes are older than queued ones
+  if (Interface::get().getSpool().isEmpty()) {
+    Interface::get().getOutboundQueue().flush();
+  } else {
+    Interface::get().getSpool().replay();
+  }
+
+  Interface::get().getRateLimiter().loop();  // coalesced publishes
+
   if (_mqttOfflineMessageId == 0 && Interface::get().flaggedForSleep) {
     Interface::get().getLogger() << F("Device in preparation to sleep...") << endl;
     _mqttOfflineMessageId = Interface::get().getMqttClient().publish(_prefixMqttTopic(PSTR("/$online")), 1, true, "false");
   }
 
   if (_statsTimer.check()) {
-    uint8_t quality = Helpers::rssiToPercentage(WiFi.RSSI());
-    char qualityStr[3 + 1];
-    itoa(quality, qualityStr, 10);
-    Interface::get().getLogger() << F("〽 Sending statistics...") << endl;
-    Interface::get().getLogger() << F("  • Wi-Fi signal quality: ") << qualityStr << F("%") << endl;
-    uint16_t signalPacketId = Interface::get().getMqttClient().publish(_prefixMqttTopic(PSTR("/$stats/signal")), 1, true, qualityStr);
-
-    _uptime.update();
-    char uptimeStr[20 + 1];
-    itoa(_uptime.getSeconds(), uptimeStr, 10);
-    Interface::get().getLogger() << F("  • Uptime: ") << uptimeStr << F("s") << endl;
-    uint16_t uptimePacketId = Interface::get().getMqttClient().publish(_prefixMqttTopic(PSTR("/$stats/uptime")), 1, true, uptimeStr);
-
-    if (signalPacketId != 0 && uptimePacketId != 0) _statsTimer.tick();
+    // as many statistics as the MQTT client buffer allows, the next loop resumes from the refused one
+    while (_statsStep != StatsStep::DONE && _sendStatistic()) {}
+    if (_statsStep == StatsStep::DONE) {
+      _statsStep = StatsStep::BEGIN;
+      _statsTimer.tick();
+    }
   }
 
   Interface::get().loopFunction();
@@ -179,6 +254,194 @@ char* BootNormal::_prefixMqttTopic(PGM_P topic) {
   return _mqttTopic.get();
 }
 
+bool BootNormal::_publishBootTiming() {
+  // resume from the refused one
+  for (; _bootTimingStep < BOOT_TIMING_STEPS_COUNT; _bootTimingStep++) {
+    char valueStr[10 + 1];
+    bool published = false;
+    switch (_bootTimingStep) {
+      case 0:
+        ultoa(_bootTiming.setup, valueStr, 10);
+        published = _publishStatistic(PSTR("/$stats/boot/setup"), valueStr);
+        break;
+      case 1:
+        ultoa(_bootTiming.wifi, valueStr, 10);
+        published = _publishStatistic(PSTR("/$stats/boot/wifi"), valueStr);
+        break;
+      case 2:
+        ultoa(_bootTiming.mqtt, valueStr, 10);
+        published = _publishStatistic(PSTR("/$stats/boot/mqtt"), valueStr);
+        break;
+      case 3:
+        ultoa(_bootTiming.advertisement, valueStr, 10);
+        published = _publishStatistic(PSTR("/$stats/boot/advertisement"), valueStr);
+        break;
+      case 4:
+        ultoa(_bootTiming.total, valueStr, 10);
+        published = _publishStatistic(PSTR("/$stats/boot/total"), valueStr);
+        break;
+    }
+    if (!published) return false;
+  }
+
+  return true;
+}
+
+void BootNormal::_connectionLost() {
+  if (_connectionTimestamps.startedAt != 0) return;  // still towards the same MQTT_READY
+
+  // a new connection starts, Homie.setup() is not part of it anymore
+  _connectionTimestamps.startedAt = millis();
+  _bootTiming.setup = 0;
+}
+
+bool BootNormal::_sendStatistic() {
+  char valueStr[20 + 1];
+  bool published = true;  // disabled statistics are skipped
+  switch (_statsStep) {
+    case StatsStep::BEGIN:
+      Interface::get().getLogger() << F("〽 Sending statistics...") << endl;
+      break;
+    case StatsStep::SIGNAL:
+      itoa(Helpers::rssiToPercentage(WiFi.RSSI()), valueStr, 10);
+      published = _publishStatistic(PSTR("/$stats/signal"), valueStr);
+      if (published) Interface::get().getLogger() << F("  • Wi-Fi signal quality: ") << valueStr << F("%") << endl;
+      break;
+    case StatsStep::UPTIME:
+      _uptime.update();
+      itoa(_uptime.getSeconds(), valueStr, 10);
+      published = _publishStatistic(PSTR("/$stats/uptime"), valueStr);
+      if (published) Interface::get().getLogger() << F("  • Uptime: ") << valueStr << F("s") << endl;
+      break;
+    case StatsStep::INPUT_BUFFER:
+      ultoa(_mqttPayloadBufferSize, valueStr, 10);
+      published = _publishStatistic(PSTR("/$stats/input/buffer"), valueStr);
+      if (published) Interface::get().getLogger() << F("  • Input buffer: ") << valueStr << F(" bytes") << endl;
+      break;
+    case StatsStep::INPUT_REJECTED:
+      ultoa(_mqttPayloadRejectedCount, valueStr, 10);
+      published = _publishStatistic(PSTR("/$stats/input/rejected"), valueStr);
+      if (published) Interface::get().getLogger() << F("  • Rejected inputs: ") << valueStr << endl;
+      break;
+    case StatsStep::INPUT_QUEUE:
+      if (!_inputQueue.isEnabled()) break;
+      itoa(_inputQueue.getDepth(), valueStr, 10);
+      published = _publishStatistic(PSTR("/$stats/input/queue"), valueStr);
+      if (published) Interface::get().getLogger() << F("  • Input queue depth: ") << valueStr << endl;
+      break;
+    case StatsStep::INPUT_PEAK:
+      if (!_inputQueue.isEnabled()) break;
+      itoa(_inputQueue.getPeakDepth(), valueStr, 10);
+      published = _publishStatistic(PSTR("/$stats/input/peak"), valueStr);
+      if (published) Interface::get().getLogger() << F("  • Input queue peak depth: ") << valueStr << endl;
+      break;
+    case StatsStep::INPUT_DROPPED:
+      if (!_inputQueue.isEnabled()) break;
+      ultoa(_inputQueue.getDroppedCount(), valueStr, 10);
+      published = _publishStatistic(PSTR("/$stats/input/dropped"), valueStr);
+      if (published) Interface::get().getLogger() << F("  • Dropped inputs: ") << valueStr << endl;
+      break;
+    case StatsStep::PUBLISH_SUPPRESSED:
+      ultoa(Interface::get().outbound.suppressedCount, valueStr, 10);
+      published = _publishStatistic(PSTR("/$stats/publish/suppressed"), valueStr);
+      if (published) Interface::get().getLogger() << F("  • Suppressed publishes: ") << valueStr << endl;
+      break;
+    case StatsStep::PUBLISH_LIMITED:
+      ultoa(Interface::get().getRateLimiter().getHitCount(), valueStr, 10);
+      published = _publishStatistic(PSTR("/$stats/publish/limited"), valueStr);
+      if (published) Interface::get().getLogger() << F("  • Rate limited publishes: ") << valueStr << endl;
+      break;
+    case StatsStep::PUBLISH_IN_FLIGHT:
+      itoa(Interface::get().getPublishTracker().getInFlightCount(), valueStr, 10);
+      published = _publishStatistic(PSTR("/$stats/publish/inflight"), valueStr);
+      if (published) Interface::get().getLogger() << F("  • Publishes in flight: ") << valueStr << endl;
+      break;
+    case StatsStep::PUBLISH_RTT:
+      ultoa(Interface::get().getPublishTracker().getAverageRtt(), valueStr, 10);
+      published = _publishStatistic(PSTR("/$stats/publish/rtt"), valueStr);
+      if (published) Interface::get().getLogger() << F("  • Average acknowledgment time: ") << valueStr << F("ms") << endl;
+      break;
+    case StatsStep::PUBLISH_TIMEOUTS:
+      ultoa(Interface::get().getPublishTracker().getTimeoutCount(), valueStr, 10);
+      published = _publishStatistic(PSTR("/$stats/publish/timeouts"), valueStr);
+      if (published) Interface::get().getLogger() << F("  • Unacknowledged publishes: ") << valueStr << endl;
+      break;
+    case StatsStep::PUBLISH_QUEUED:
+      if (!Interface::get().getOutboundQueue().isEnabled()) break;
+      itoa(Interface::get().getOutboundQueue().getDepth(), valueStr, 10);
+      published = _publishStatistic(PSTR("/$stats/publish/queued"), valueStr);
+      if (published) Interface::get().getLogger() << F("  • Queued publishes: ") << valueStr << endl;
+      break;
+    case StatsStep::PUBLISH_DROPPED:
+      if (!Interface::get().getOutboundQueue().isEnabled()) break;
+      ultoa(Interface::get().getOutboundQueue().getDroppedCount(), valueStr, 10);
+      published = _publishStatistic(PSTR("/$stats/publish/dropped"), valueStr);
+      if (published) Interface::get().getLogger() << F("  • Dropped publishes: ") << valueStr << endl;
+      break;
+    case StatsStep::SPOOL_PENDING:
+      if (!Interface::get().getSpool().isEnabled()) break;
+      ultoa(Interface::get().getSpool().getPendingCount(), valueStr, 10);
+      published = _publishStatistic(PSTR("/$stats/spool/pending"), valueStr);
+      if (published) Interface::get().getLogger() << F("  • Spooled publishes: ") << valueStr << endl;
+      break;
+    case StatsStep::SPOOL_DROPPED:
+      if (!Interface::get().getSpool().isEnabled()) break;
+      ultoa(Interface::get().getSpool().getDroppedCount(), valueStr, 10);
+      published = _publishStatistic(PSTR("/$stats/spool/dropped"), valueStr);
+      if (published) Interface::get().getLogger() << F("  • Dropped spooled publishes: ") << valueStr << endl;
+      break;
+    case StatsStep::LATENCY_SET:
+      published = _publishLatency(PSTR("/$stats/latency/set"), F("Input"), LatencyPath::INPUT_SET);
+      break;
+    case StatsStep::LATENCY_BROADCAST:
+      published = _publishLatency(PSTR("/$stats/latency/broadcast"), F("Broadcast"), LatencyPath::BROADCAST);
+      break;
+    case StatsStep::LATENCY_CONFIG:
+      published = _publishLatency(PSTR("/$stats/latency/config"), F("Config"), LatencyPath::CONFIG);
+      break;
+    case StatsStep::LATENCY_OTA:
+      published = _publishLatency(PSTR("/$stats/latency/ota"), F("OTA chunk"), LatencyPath::OTA_CHUNK);
+      break;
+    case StatsStep::LATENCY_PUBLISH:
+      published = _publishLatency(PSTR("/$stats/latency/publish"), F("Publish"), LatencyPath::PUBLISH);
+      break;
+    case StatsStep::DONE:
+      return false;
+  }
+
+  if (!published) return false;  // client buffer full, resume from the same statistic
+
+  _statsStep = static_cast<StatsStep>(static_cast<uint8_t>(_statsStep) + 1);
+  return true;
+}
+
+bool BootNormal::_publishStatistic(PGM_P topic, const char* value) {
+  // statistics wait for the room left by property values, and take their share of it
+  PublishTracker& publishTracker = Interface::get().getPublishTracker();
+  char* fullTopic = _prefixMqttTopic(topic);
+  size_t length = strlen(fullTopic) + strlen(value);
+  if (!publishTracker.canPublish(length)) return false;
+
+  uint16_t packetId = Interface::get().getMqttClient().publish(fullTopic, 1, true, value);
+  if (packetId == 0) {
+    publishTracker.rejected();
+    return false;
+  }
+
+  publishTracker.track(packetId, 1, length, micros());
+  return true;
+}
+
+bool BootNormal::_publishLatency(PGM_P topic, const __FlashStringHelper* name, LatencyPath path) {
+  const LatencyHistogram& histogram = Interface::get().getLatency().get(path);
+  char bucketsStr[LATENCY_BUCKETS_COUNT * (10 + 1)];
+  histogram.printBuckets(bucketsStr);
+  if (!_publishStatistic(topic, bucketsStr)) return false;
+
+  Interface::get().getLogger() << F("  • ") << name << F(" latency: ") << histogram.getCount() << F(" samples, max ") << histogram.getMax() << F("µs") << endl;
+  return true;
+}
+
 bool BootNormal::_publishOtaStatus(int status, const char* info) {
   String payload(status);
   if (info) {
@@ -240,6 +503,8 @@ void BootNormal::_endOtaUpdate(bool success, uint8_t update_error) {
 }
 
 void BootNormal::_wifiConnect() {
+  if (_connectionTimestamps.wifiConnectAt == 0) _connectionTimestamps.wifiConnectAt = millis();
+
   if (!Interface::get().disable) {
     if (Interface::get().led.enabled) Interface::get().getBlinker().start(LED_WIFI_DELAY);
     Interface::get().getLogger() << F("↕ Attempting to connect to Wi-Fi...") << endl;
@@ -284,6 +549,7 @@ void BootNormal::_wifiConnect() {
 }
 
 void BootNormal::_onWifiGotIp(const WiFiEventStationModeGotIP& event) {
+  _connectionTimestamps.wifiConnectedAt = millis();
   if (Interface::get().led.enabled) Interface::get().getBlinker().stop();
   Interface::get().getLogger() << F("✔ Wi-Fi connected, IP: ") << event.ip << endl;
   Interface::get().getLogger() << F("Triggering WIFI_CONNECTED event...") << endl;
@@ -299,8 +565,10 @@ void BootNormal::_onWifiGotIp(const WiFiEventStationModeGotIP& event) {
 
 void BootNormal::_onWifiDisconnected(const WiFiEventStationModeDisconnected& event) {
   Interface::get().ready = false;
+  _connectionLost();
   if (Interface::get().led.enabled) Interface::get().getBlinker().start(LED_WIFI_DELAY);
   _statsTimer.reset();
+  _statsStep = StatsStep::BEGIN;
   Interface::get().getLogger() << F("✖ Wi-Fi disconnected") << endl;
   Interface::get().getLogger() << F("Triggering WIFI_DISCONNECTED event...") << endl;
   Interface::get().event.type = HomieEventType::WIFI_DISCONNECTED;
@@ -311,6 +579,8 @@ void BootNormal::_onWifiDisconnected(const WiFiEventStationModeDisconnected& eve
 }
 
 void BootNormal::_mqttConnect() {
+  if (_connectionTimestamps.mqttConnectAt == 0) _connectionTimestamps.mqttConnectAt = millis();
+
   if (!Interface::get().disable) {
     if (Interface::get().led.enabled) Interface::get().getBlinker().start(LED_MQTT_DELAY);
     Interface::get().getLogger() << F("↕ Attempting to connect to MQTT...") << endl;
@@ -318,10 +588,15 @@ void BootNormal::_mqttConnect() {
   }
 }
 
-void BootNormal::_advertise() {
-  uint16_t packetId;
+bool BootNormal::_advertise() {
+  uint16_t packetId = 0;
   switch (_advertisementProgress.globalStep) {
     case AdvertisementProgress::GlobalStep::PUB_HOMIE:
+      if (_advertisementProgress.skipUnchanged) {
+        // the broker still holds $homie, $name and $mac
+        _advertisementProgress.globalStep = AdvertisementProgress::GlobalStep::PUB_LOCALIP;
+        return _advertise();
+      }
       packetId = Interface::get().getMqttClient().publish(_prefixMqttTopic(PSTR("/$homie")), 1, true, HOMIE_VERSION);
       if (packetId != 0) _advertisementProgress.globalStep = AdvertisementProgress::GlobalStep::PUB_NAME;
       break;
@@ -339,21 +614,13 @@ void BootNormal::_advertise() {
       char localIpStr[MAX_IP_STRING_LENGTH];
       Helpers::ipToString(localIp, localIpStr);
       packetId = Interface::get().getMqttClient().publish(_prefixMqttTopic(PSTR("/$localip")), 1, true, localIpStr);
-      if (packetId != 0) _advertisementProgress.globalStep = AdvertisementProgress::GlobalStep::PUB_NODES_ATTR;
+      if (packetId != 0) _advertisementProgress.globalStep = _advertisementProgress.skipUnchanged ? AdvertisementProgress::GlobalStep::PUB_ONLINE : AdvertisementProgress::GlobalStep::PUB_NODES_ATTR;
       break;
     }
     case AdvertisementProgress::GlobalStep::PUB_NODES_ATTR:
-    {
-      String nodes;
-      for (HomieNode* node : HomieNode::nodes) {
-        nodes.concat(node->getId());
-        nodes.concat(F(","));
-      }
-      if (HomieNode::nodes.size() >= 1) nodes.remove(nodes.length() - 1);
-      packetId = Interface::get().getMqttClient().publish(_prefixMqttTopic(PSTR("/$nodes")), 1, true, nodes.c_str());
+      packetId = Interface::get().getMqttClient().publish(_prefixMqttTopic(PSTR("/$nodes")), 1, true, _advertisementPayloads.get());
       if (packetId != 0) _advertisementProgress.globalStep = AdvertisementProgress::GlobalStep::PUB_STATS_INTERVAL;
       break;
-    }
     case AdvertisementProgress::GlobalStep::PUB_STATS_INTERVAL:
       char statsIntervalStr[3 + 1];
       itoa(STATS_SEND_INTERVAL_SEC / 1000, statsIntervalStr, 10);
@@ -377,13 +644,9 @@ void BootNormal::_advertise() {
       if (packetId != 0) _advertisementProgress.globalStep = AdvertisementProgress::GlobalStep::PUB_IMPLEMENTATION_CONFIG;
       break;
     case AdvertisementProgress::GlobalStep::PUB_IMPLEMENTATION_CONFIG:
-    {
-      char* safeConfigFile = Interface::get().getConfig().getSafeConfigFile();
-      packetId = Interface::get().getMqttClient().publish(_prefixMqttTopic(PSTR("/$implementation/config")), 1, true, safeConfigFile);
-      free(safeConfigFile);
+      packetId = Interface::get().getMqttClient().publish(_prefixMqttTopic(PSTR("/$implementation/config")), 1, true, Interface::get().getConfig().getSafeConfigFile());
       if (packetId != 0) _advertisementProgress.globalStep = AdvertisementProgress::GlobalStep::PUB_IMPLEMENTATION_VERSION;
       break;
-    }
     case AdvertisementProgress::GlobalStep::PUB_IMPLEMENTATION_VERSION:
       packetId = Interface::get().getMqttClient().publish(_prefixMqttTopic(PSTR("/$implementation/version")), 1, true, HOMIE_ESP8266_VERSION);
       if (packetId != 0) _advertisementProgress.globalStep = AdvertisementProgress::GlobalStep::PUB_IMPLEMENTATION_OTA_ENABLED;
@@ -403,34 +666,18 @@ void BootNormal::_advertise() {
     case AdvertisementProgress::GlobalStep::PUB_NODES:
     {
       HomieNode* node = HomieNode::nodes[_advertisementProgress.currentNodeIndex];
-      std::unique_ptr<char[]> subtopic = std::unique_ptr<char[]>(new char[1 + strlen(node->getId()) + 12 + 1]);  // /id/$properties
+      _prefixMqttTopic();  // sized at setup for /id/$properties
+      strcat_P(_mqttTopic.get(), PSTR("/"));
+      strcat(_mqttTopic.get(), node->getId());
       switch (_advertisementProgress.nodeStep) {
         case AdvertisementProgress::NodeStep::PUB_TYPE:
-          strcpy_P(subtopic.get(), PSTR("/"));
-          strcat(subtopic.get(), node->getId());
-          strcat_P(subtopic.get(), PSTR("/$type"));
-          packetId = Interface::get().getMqttClient().publish(_prefixMqttTopic(subtopic.get()), 1, true, node->getType());
+          strcat_P(_mqttTopic.get(), PSTR("/$type"));
+          packetId = Interface::get().getMqttClient().publish(_mqttTopic.get(), 1, true, node->getType());
           if (packetId != 0) _advertisementProgress.nodeStep = AdvertisementProgress::NodeStep::PUB_PROPERTIES;
           break;
         case AdvertisementProgress::NodeStep::PUB_PROPERTIES:
-          strcpy_P(subtopic.get(), PSTR("/"));
-          strcat(subtopic.get(), node->getId());
-          strcat_P(subtopic.get(), PSTR("/$properties"));
-          String properties;
-          for (Property* iProperty : node->getProperties()) {
-            properties.concat(iProperty->getProperty());
-            if (iProperty->isRange()) {
-              properties.concat("[");
-              properties.concat(iProperty->getLower());
-              properties.concat("-");
-              properties.concat(iProperty->getUpper());
-              properties.concat("]");
-            }
-            if (iProperty->isSettable()) properties.concat(":settable");
-            properties.concat(",");
-          }
-          if (node->getProperties().size() >= 1) properties.remove(properties.length() - 1);
-          packetId = Interface::get().getMqttClient().publish(_prefixMqttTopic(subtopic.get()), 1, true, properties.c_str());
+          strcat_P(_mqttTopic.get(), PSTR("/$properties"));
+          packetId = Interface::get().getMqttClient().publish(_mqttTopic.get(), 1, true, _propertiesPayloads[_advertisementProgress.currentNodeIndex]);
           if (packetId != 0) {
             if (_advertisementProgress.currentNodeIndex < HomieNode::nodes.size() - 1) {
               _advertisementProgress.currentNodeIndex++;
@@ -461,10 +708,27 @@ void BootNormal::_advertise() {
       break;
     case AdvertisementProgress::GlobalStep::SUB_BROADCAST:
     {
+      const std::vector<InterfaceData::BroadcastSubscription>& subscriptions = Interface::get().broadcastSubscriptions;
       String broadcast_topic(Interface::get().getConfig().get().mqtt.baseTopic);
-      broadcast_topic.concat("$broadcast/+");
-      packetId = Interface::get().getMqttClient().subscribe(broadcast_topic.c_str(), 2);
-      if (packetId != 0) _advertisementProgress.globalStep = AdvertisementProgress::GlobalStep::PUB_ONLINE;
+      broadcast_topic.concat("$broadcast/");
+      if (subscriptions.empty()) {
+        broadcast_topic.concat("+");
+        packetId = Interface::get().getMqttClient().subscribe(broadcast_topic.c_str(), 2);
+        if (packetId != 0) _advertisementProgress.globalStep = AdvertisementProgress::GlobalStep::PUB_ONLINE;
+        break;
+      }
+
+      const InterfaceData::BroadcastSubscription& subscription = subscriptions[_advertisementProgress.currentBroadcastIndex];
+      broadcast_topic.concat(subscription.level);
+      packetId = Interface::get().getMqttClient().subscribe(broadcast_topic.c_str(), subscription.qos);
+      if (packetId != 0) {
+        if (_advertisementProgress.currentBroadcastIndex < subscriptions.size() - 1) {
+          _advertisementProgress.currentBroadcastIndex++;
+        } else {
+          _advertisementProgress.currentBroadcastIndex = 0;
+          _advertisementProgress.globalStep = AdvertisementProgress::GlobalStep::PUB_ONLINE;
+        }
+      }
       break;
     }
     case AdvertisementProgress::GlobalStep::PUB_ONLINE:
@@ -472,26 +736,137 @@ void BootNormal::_advertise() {
       if (packetId != 0) _advertisementProgress.done = true;
       break;
   }
+
+  if (packetId == 0) return false;  // client buffer full, resume from the same step
+
+  _advertisementProgress.inFlightPacketIds[_advertisementProgress.inFlightCount++] = packetId;
+  return true;
+}
+
+uint32_t BootNormal::_computeAdvertisementFingerprint() {
+  AdvertisementFingerprint fingerprint;
+  fingerprint.add(_prefixMqttTopic(PSTR("")));
+  fingerprint.add(HOMIE_VERSION);
+  fingerprint.add(Interface::get().getConfig().get().name);
+  fingerprint.add(WiFi.macAddress().c_str());
+
+  fingerprint.add(_advertisementPayloads.get());
+
+  char statsIntervalStr[3 + 1];
+  itoa(STATS_SEND_INTERVAL_SEC / 1000, statsIntervalStr, 10);
+  fingerprint.add(statsIntervalStr);
+  fingerprint.add(Interface::get().firmware.name);
+  fingerprint.add(Interface::get().firmware.version);
+  fingerprint.add(_fwChecksum);
+
+  fingerprint.add(Interface::get().getConfig().getSafeConfigFile());
+  fingerprint.add(HOMIE_ESP8266_VERSION);
+
+  for (size_t i = 0; i < HomieNode::nodes.size(); i++) {
+    fingerprint.add(HomieNode::nodes[i]->getId());
+    fingerprint.add(HomieNode::nodes[i]->getType());
+    fingerprint.add(_propertiesPayloads[i]);
+  }
+
+  for (const InterfaceData::BroadcastSubscription& subscription : Interface::get().broadcastSubscriptions) {
+    char qosStr[1 + 1];
+    itoa(subscription.qos, qosStr, 10);
+    fingerprint.add(subscription.level);
+    fingerprint.add(qosStr);
+  }
+
+  return fingerprint.get();
+}
+
+void BootNormal::_renderAdvertisementPayloads() {
+  // nodes and properties are frozen, so reconnections do not need to allocate anything
+  size_t size = _renderNodesAttribute(nullptr) + 1;
+  for (HomieNode* iNode : HomieNode::nodes) {
+    size += _renderPropertiesAttribute(*iNode, nullptr) + 1;
+  }
+
+  _advertisementPayloads = std::unique_ptr<char[]>(new char[size]);
+  _propertiesPayloads = std::unique_ptr<const char*[]>(new const char*[HomieNode::nodes.size()]);
+
+  char* cursor = _advertisementPayloads.get();
+  cursor += _renderNodesAttribute(cursor) + 1;
+  for (size_t i = 0; i < HomieNode::nodes.size(); i++) {
+    _propertiesPayloads[i] = cursor;
+    cursor += _renderPropertiesAttribute(*HomieNode::nodes[i], cursor) + 1;
+  }
+}
+
+size_t BootNormal::_renderNodesAttribute(char* buffer) {
+  size_t length = 0;
+  for (HomieNode* iNode : HomieNode::nodes) {
+    if (length > 0) length += _append(buffer, length, ",");
+    length += _append(buffer, length, iNode->getId());
+  }
+  if (buffer != nullptr) buffer[length] = '\0';
+
+  return length;
+}
+
+size_t BootNormal::_renderPropertiesAttribute(const HomieNode& node, char* buffer) {
+  size_t length = 0;
+  char boundStr[5 + 1];  // max 65535
+  for (Property* iProperty : node.getProperties()) {
+    if (length > 0) length += _append(buffer, length, ",");
+    length += _append(buffer, length, iProperty->getProperty());
+    if (iProperty->isRange()) {
+      length += _append(buffer, length, "[");
+      utoa(iProperty->getLower(), boundStr, 10);
+      length += _append(buffer, length, boundStr);
+      length += _append(buffer, length, "-");
+      utoa(iProperty->getUpper(), boundStr, 10);
+      length += _append(buffer, length, boundStr);
+      length += _append(buffer, length, "]");
+    }
+    if (iProperty->isSettable()) length += _append(buffer, length, ":settable");
+  }
+  if (buffer != nullptr) buffer[length] = '\0';
+
+  return length;
+}
+
+size_t BootNormal::_append(char* buffer, size_t offset, const char* value) {
+  // only measures without a buffer
+  size_t length = strlen(value);
+  if (buffer != nullptr) memcpy(buffer + offset, value, length);
+
+  return length;
 }
 
-void BootNormal::_onMqttConnected() {
+void BootNormal::_onMqttConnected(bool sessionPresent) {
+  _connectionTimestamps.mqttConnectedAt = millis();
   _mqttDisconnectNotified = false;
   _mqttReconnectTimer.deactivate();
 
-  Interface::get().getLogger() << F("Sending initial information...") << endl;
+  if (Interface::get().advertisement.skipUnchanged && sessionPresent && _advertisedFingerprintValid && _advertisedFingerprint == _advertisementFingerprint) {
+    Interface::get().getLogger() << F("Advertisement unchanged, only sending $localip and $online...") << endl;
+    _advertisementProgress.skipUnchanged = true;
+  } else {
+    Interface::get().getLogger() << F("Sending initial information...") << endl;
+  }
 
   _advertise();
 }
 
 void BootNormal::_onMqttDisconnected(AsyncMqttClientDisconnectReason reason) {
   Interface::get().ready = false;
+  _connectionLost();
   _mqttConnectNotified = false;
   _advertisementProgress.done = false;
+  _advertisementProgress.skipUnchanged = false;
   _advertisementProgress.globalStep = AdvertisementProgress::GlobalStep::PUB_HOMIE;
   _advertisementProgress.nodeStep = AdvertisementProgress::NodeStep::PUB_TYPE;
   _advertisementProgress.currentNodeIndex = 0;
+  _advertisementProgress.currentBroadcastIndex = 0;
+  _advertisementProgress.inFlightCount = 0;
+  Interface::get().getPublishTracker().clear();  // acknowledgments are lost with the session
   if (!_mqttDisconnectNotified) {
     _statsTimer.reset();
+    _statsStep = StatsStep::BEGIN;
     Interface::get().getLogger() << F("✖ MQTT disconnected") << endl;
     Interface::get().getLogger() << F("Triggering MQTT_DISCONNECTED event...") << endl;
     Interface::get().event.type = HomieEventType::MQTT_DISCONNECTED;
@@ -519,40 +894,49 @@ void BootNormal::_onMqttDisconnected(AsyncMqttClientDisconnectReason reason) {
 void BootNormal::_onMqttMessage(char* topic, char* payload, AsyncMqttClientMessageProperties properties, size_t len, size_t index, size_t total) {
   if (total == 0) return;  // no empty message possible
 
-  // split topic on each "/"
+  uint32_t receivedAt = micros();
+
+  // split topic on each "/" and resolve its route once per message
   if (index == 0) {
+    _mqttMessageReceivedAt = receivedAt;
     __splitTopic(topic);
+    __routeTopic();
   }
 
-  // 1. Handle OTA firmware (not copied to payload buffer)
-  if (__handleOTAUpdates(topic, payload, properties, len, index, total))
-    return;
+  switch (_mqttRoute) {
+    case MqttRoute::UNROUTED:
+      return;
+    case MqttRoute::OTA_FIRMWARE:  // not copied to payload buffer
+      __handleOTAUpdates(topic, payload, properties, len, index, total);
+      Interface::get().getLatency().get(LatencyPath::OTA_CHUNK).record(micros() - receivedAt);
+      return;
+    case MqttRoute::NODE_PROPERTY_STREAM:  // not copied to payload buffer either
+      __handleNodePropertyStream(topic, payload, properties, len, index, total);
+      return;
+    default:
+      break;
+  }
 
-  // 2. Fill Payload Buffer
   if (__fillPayloadBuffer(topic, payload, properties, len, index, total))
     return;
 
   /* Arrived here, the payload is complete */
 
-  // 3. handle broadcasts
-  if (__handleBroadcasts(topic, payload, properties, len, index, total))
-    return;
-
-  // 4.all following messages are only for this deviceId
-  if (strcmp(_mqttTopicLevels.get()[0], Interface::get().getConfig().get().deviceId) != 0)
-    return;
-
-  // 5. handle reset
-  if (__handleResets(topic, payload, properties, len, index, total))
-    return;
-
-  // 6. handle config set
-  if (__handleConfig(topic, payload, properties, len, index, total))
-    return;
-
-  // 7. here, we're sure we have a node property
-  if (__handleNodeProperty(topic, payload, properties, len, index, total))
-    return;
+  InputMessage message;
+  message.route = static_cast<uint8_t>(_mqttRoute);
+  message.node = _mqttRouteNode;
+  message.property = _mqttRouteProperty;
+  message.range = _mqttRouteRange;
+  message.level = _mqttRoute == MqttRoute::BROADCAST ? _mqttTopicLevels.get()[1] : "";
+  message.payload = _mqttPayloadBuffer.get();
+  message.length = total;
+  message.receivedAt = _mqttMessageReceivedAt;
+
+  if (_inputQueue.isEnabled()) {
+    _inputQueue.push(message);  // handled from loop()
+  } else {
+    __handleInputMessage(message);
+  }
 }
 
 void BootNormal::_onMqttPublish(uint16_t id) {
@@ -560,40 +944,160 @@ void BootNormal::_onMqttPublish(uint16_t id) {
   Interface::get().event.packetId = id;
   Interface::get().eventHandler(Interface::get().event);
 
+  Interface::get().getPublishTracker().acknowledge(id);
+  _acknowledgeAdvertisement(id);
+
   if (Interface::get().flaggedForSleep && id == _mqttOfflineMessageId) {
     Interface::get().getLogger() << F("Offline message acknowledged. Disconnecting MQTT...") << endl;
     Interface::get().getMqttClient().disconnect();
   }
 }
 
+void BootNormal::_onMqttSubscribe(uint16_t id, uint8_t qos) {
+  _acknowledgeAdvertisement(id);
+}
+
+void BootNormal::_acknowledgeAdvertisement(uint16_t id) {
+  for (uint8_t i = 0; i < _advertisementProgress.inFlightCount; i++) {
+    if (_advertisementProgress.inFlightPacketIds[i] != id) continue;
+
+    _advertisementProgress.inFlightPacketIds[i] = _advertisementProgress.inFlightPacketIds[--_advertisementProgress.inFlightCount];
+    return;
+  }
+}
+
 // _onMqttMessage Helpers
 
 void BootNormal::__splitTopic(char* topic) {
-  // split topic on each "/"
-  char* afterBaseTopic = topic + strlen(Interface::get().getConfig().get().mqtt.baseTopic);
+  // split topic in place on each "/", in a single pass and without allocating
+  char* level = topic + strlen(Interface::get().getConfig().get().mqtt.baseTopic);
+
+  _mqttTopicLevelsCount = 0;
+  while (true) {
+    // levels deeper than any routed topic are counted but not indexed
+    if (_mqttTopicLevelsCount < _mqttTopicLevelsCapacity) _mqttTopicLevels[_mqttTopicLevelsCount] = level;
+    _mqttTopicLevelsCount++;
+
+    char* separator = strchr(level, '/');
+    if (!separator) break;
+
+    *separator = '\0';
+    level = separator + 1;
+  }
+}
+
+void BootNormal::__buildRoutes() {
+  HomieNode::buildIndex();
 
-  uint8_t topicLevelsCount = 1;
-  for (uint8_t i = 0; i < strlen(afterBaseTopic); i++) {
-    if (afterBaseTopic[i] == '/') topicLevelsCount++;
+  _mqttTopicLevelsCapacity = 4;  // <id>/<node>/<property>/set
+  for (uint8_t i = 0; i < IMPLEMENTATION_ROUTES_COUNT; i++) {
+    if (IMPLEMENTATION_ROUTES[i].levelsCount > _mqttTopicLevelsCapacity) _mqttTopicLevelsCapacity = IMPLEMENTATION_ROUTES[i].levelsCount;
+  }
+  _mqttTopicLevels = std::unique_ptr<char*[]>(new char*[_mqttTopicLevelsCapacity]);
+}
+
+void BootNormal::__routeTopic() {
+  _mqttRoute = MqttRoute::UNROUTED;
+  _mqttRouteNode = nullptr;
+  _mqttRouteProperty = nullptr;
+
+  if (_mqttTopicLevelsCount > _mqttTopicLevelsCapacity) return;
+
+  char** levels = _mqttTopicLevels.get();
+
+  if (_mqttTopicLevelsCount == 2 && strcmp_P(levels[0], PSTR("$broadcast")) == 0) {
+    _mqttRoute = MqttRoute::BROADCAST;
+    return;
   }
 
-  _mqttTopicLevels = std::unique_ptr<char*[]>(new char*[topicLevelsCount]);
-  _mqttTopicLevelsCount = topicLevelsCount;
+  // all following messages are only for this deviceId
+  if (_mqttTopicLevelsCount < 3 || strcmp(levels[0], Interface::get().getConfig().get().deviceId) != 0) return;
 
-  const char* delimiter = "/";
-  uint8_t topicLevelIndex = 0;
+  if (strcmp_P(levels[1], PSTR("$implementation")) == 0) {
+    for (uint8_t i = 0; i < IMPLEMENTATION_ROUTES_COUNT; i++) {
+      const ImplementationRoute& route = IMPLEMENTATION_ROUTES[i];
+      if (_mqttTopicLevelsCount != route.levelsCount) continue;
+      if (strcmp(levels[2], route.level2) != 0) continue;
+      if (route.level3 && strcmp(levels[3], route.level3) != 0) continue;
 
-  char* token = strtok(afterBaseTopic, delimiter);
-  while (token != nullptr) {
-    _mqttTopicLevels[topicLevelIndex++] = token;
+      _mqttRoute = route.route;
+      return;
+    }
 
-    token = strtok(nullptr, delimiter);
+    return;
   }
+
+  // here, it can only be <id>/<node>/<property>/set
+  if (_mqttTopicLevelsCount != 4) return;
+
+  if (!__routeNodeProperty(levels[1], levels[2])) return;
+
+  _mqttRoute = _mqttRouteProperty->isStreaming() ? MqttRoute::NODE_PROPERTY_STREAM : MqttRoute::NODE_PROPERTY;
+}
+
+bool BootNormal::__routeNodeProperty(char* node, char* property) {
+  // initialize HomieRange
+  HomieRange range;
+  range.isRange = false;
+  range.index = 0;
+
+  char* rangeSeparator = strchr(property, '_');
+  if (rangeSeparator) {
+    range.isRange = true;
+    *rangeSeparator = '\0';
+    char* rangeIndexStr = rangeSeparator + 1;
+    if (!Helpers::parseRangeIndex(rangeIndexStr, &range.index)) {
+      Interface::get().getLogger() << F("Range index ") << rangeIndexStr << F(" is not valid") << endl;
+      return false;
+    }
+  }
+
+  // resolve node and property in a single lookup
+  Property* propertyObject = HomieNode::findProperty(node, property, &_mqttRouteNode);
+  if (!_mqttRouteNode) {
+    Interface::get().getLogger() << F("Node ") << node << F(" not registered") << endl;
+    return false;
+  }
+
+#ifdef DEBUG
+  Interface::get().getLogger() << F("Recived network message for ") << _mqttRouteNode->getId() << endl;
+#endif // DEBUG
+
+  if (propertyObject && range.isRange) {
+    if (!propertyObject->isRange()) {
+      propertyObject = nullptr;
+    } else if (range.index < propertyObject->getLower() || range.index > propertyObject->getUpper()) {
+      Interface::get().getLogger() << F("Range index ") << range.index << F(" is not within the bounds of ") << property << endl;
+      return false;
+    }
+  }
+
+  if (!propertyObject || !propertyObject->isSettable()) {
+    Interface::get().getLogger() << F("Node ") << node << F(": ") << property << F(" property not settable") << endl;
+    return false;
+  }
+
+  _mqttRouteProperty = propertyObject;
+  _mqttRouteRange = range;
+  return true;
 }
 
 bool HomieInternals::BootNormal::__fillPayloadBuffer(char * topic, char * payload, const AsyncMqttClientMessageProperties& properties, size_t len, size_t index, size_t total) {
-  // Reallocate Buffer everytime a new message is received
-  if (_mqttPayloadBuffer == nullptr || index == 0) _mqttPayloadBuffer = std::unique_ptr<char[]>(new char[total + 1]);
+  if (index == 0) {
+    // reject oversized payloads before allocating anything
+    if (total > Interface::get().inbound.maxPayloadSize) {
+      _mqttPayloadRejectedCount++;
+      _mqttRoute = MqttRoute::UNROUTED;  // drop the remaining chunks
+      Interface::get().getLogger() << F("✖ Payload of ") << total << F(" bytes exceeds the limit of ") << Interface::get().inbound.maxPayloadSize << F(" bytes, ignoring") << endl;
+      return true;
+    }
+
+    // only grow the buffer, the high-water mark is kept for the next messages
+    if (total + 1 > _mqttPayloadBufferSize) {
+      _mqttPayloadBuffer = std::unique_ptr<char[]>(new char[total + 1]);
+      _mqttPayloadBufferSize = total + 1;
+    }
+  }
 
   // copy payload into buffer
   memcpy(_mqttPayloadBuffer.get() + index, payload, len);
@@ -606,318 +1110,263 @@ bool HomieInternals::BootNormal::__fillPayloadBuffer(char * topic, char * payloa
   return false;
 }
 
-bool HomieInternals::BootNormal::__handleOTAUpdates(char* topic, char* payload, const AsyncMqttClientMessageProperties& properties, size_t len, size_t index, size_t total) {
-  if (
-    _mqttTopicLevelsCount == 5
-    && strcmp(_mqttTopicLevels.get()[0], Interface::get().getConfig().get().deviceId) == 0
-    && strcmp_P(_mqttTopicLevels.get()[1], PSTR("$implementation")) == 0
-    && strcmp_P(_mqttTopicLevels.get()[2], PSTR("ota")) == 0
-    && strcmp_P(_mqttTopicLevels.get()[3], PSTR("firmware")) == 0
-    ) {
-    if (index == 0) {
-      Interface::get().getLogger() << F("Receiving OTA payload") << endl;
-      if (!Interface::get().getConfig().get().ota.enabled) {
-        _publishOtaStatus(403);  // 403 Forbidden
-        Interface::get().getLogger() << F("✖ Aborting, OTA not enabled") << endl;
-        return true;
-      }
+void BootNormal::__handleInputMessage(const InputMessage& message) {
+  switch (static_cast<MqttRoute>(message.route)) {
+    case MqttRoute::BROADCAST:
+      __handleBroadcasts(message);
+      Interface::get().getLatency().get(LatencyPath::BROADCAST).record(micros() - message.receivedAt);
+      break;
+    case MqttRoute::RESET:
+      __handleResets(message);
+      break;
+    case MqttRoute::CONFIG_SET:
+      __handleConfig(message);
+      Interface::get().getLatency().get(LatencyPath::CONFIG).record(micros() - message.receivedAt);
+      break;
+    case MqttRoute::NODE_PROPERTY:
+      __handleNodeProperty(message);
+      Interface::get().getLatency().get(LatencyPath::INPUT_SET).record(micros() - message.receivedAt);
+      break;
+    default:
+      break;
+  }
+}
 
-      char* firmwareMd5 = _mqttTopicLevels.get()[4];
-      if (!Helpers::validateMd5(firmwareMd5)) {
-        _endOtaUpdate(false, UPDATE_ERROR_MD5);
-        Interface::get().getLogger() << F("✖ Aborting, invalid MD5") << endl;
-        return true;
-      } else if (strcmp(firmwareMd5, _fwChecksum) == 0) {
-        _publishOtaStatus(304);  // 304 Not Modified
-        Interface::get().getLogger() << F("✖ Aborting, firmware is the same") << endl;
-        return true;
-      } else {
-        Update.setMD5(firmwareMd5);
-        _publishOtaStatus(202);
-        _otaOngoing = true;
-
-        Interface::get().getLogger() << F("↕ OTA started") << endl;
-        Interface::get().getLogger() << F("Triggering OTA_STARTED event...") << endl;
-        Interface::get().event.type = HomieEventType::OTA_STARTED;
-        Interface::get().eventHandler(Interface::get().event);
-      }
-    } else if (!_otaOngoing) {
-      return true; // we've not validated the checksum
+void BootNormal::__handleOTAUpdates(char* topic, char* payload, const AsyncMqttClientMessageProperties& properties, size_t len, size_t index, size_t total) {
+  if (index == 0) {
+    Interface::get().getLogger() << F("Receiving OTA payload") << endl;
+    if (!Interface::get().getConfig().get().ota.enabled) {
+      _publishOtaStatus(403);  // 403 Forbidden
+      Interface::get().getLogger() << F("✖ Aborting, OTA not enabled") << endl;
+      return;
     }
 
-    // here, we need to flash the payload
+    char* firmwareMd5 = _mqttTopicLevels.get()[4];
+    if (!Helpers::validateMd5(firmwareMd5)) {
+      _endOtaUpdate(false, UPDATE_ERROR_MD5);
+      Interface::get().getLogger() << F("✖ Aborting, invalid MD5") << endl;
+      return;
+    } else if (strcmp(firmwareMd5, _fwChecksum) == 0) {
+      _publishOtaStatus(304);  // 304 Not Modified
+      Interface::get().getLogger() << F("✖ Aborting, firmware is the same") << endl;
+      return;
+    } else {
+      Update.setMD5(firmwareMd5);
+      _publishOtaStatus(202);
+      _otaOngoing = true;
+
+      Interface::get().getLogger() << F("↕ OTA started") << endl;
+      Interface::get().getLogger() << F("Triggering OTA_STARTED event...") << endl;
+      Interface::get().event.type = HomieEventType::OTA_STARTED;
+      Interface::get().eventHandler(Interface::get().event);
+    }
+  } else if (!_otaOngoing) {
+    return; // we've not validated the checksum
+  }
 
-    if (index == 0) {
-      // Autodetect if firmware is binary or base64-encoded. ESP firmware always has a magic first byte 0xE9.
-      if (*payload == 0xE9) {
-        _otaIsBase64 = false;
-        Interface::get().getLogger() << F("Firmware is binary") << endl;
-      } else {
-        // Base64-decode first two bytes. Compare decoded value against magic byte.
-        char plain[2];  // need 12 bits
-        base64_init_decodestate(&_otaBase64State);
-        int l = base64_decode_block(payload, 2, plain, &_otaBase64State);
-        if ((l == 1) && (plain[0] == 0xE9)) {
-          _otaIsBase64 = true;
-          _otaBase64Pads = 0;
-          Interface::get().getLogger() << F("Firmware is base64-encoded") << endl;
-          if (total % 4) {
-            // Base64 encoded length not a multiple of 4 bytes
-            _endOtaUpdate(false, UPDATE_ERROR_MAGIC_BYTE);
-            return true;
-          }
+  // here, we need to flash the payload
 
-          // Restart base64-decoder
-          base64_init_decodestate(&_otaBase64State);
-        } else {
-          // Bad firmware format
+  if (index == 0) {
+    // Autodetect if firmware is binary or base64-encoded. ESP firmware always has a magic first byte 0xE9.
+    if (*payload == 0xE9) {
+      _otaIsBase64 = false;
+      Interface::get().getLogger() << F("Firmware is binary") << endl;
+    } else {
+      // Base64-decode first two bytes. Compare decoded value against magic byte.
+      char plain[2];  // need 12 bits
+      base64_init_decodestate(&_otaBase64State);
+      int l = base64_decode_block(payload, 2, plain, &_otaBase64State);
+      if ((l == 1) && (plain[0] == 0xE9)) {
+        _otaIsBase64 = true;
+        _otaBase64Pads = 0;
+        Interface::get().getLogger() << F("Firmware is base64-encoded") << endl;
+        if (total % 4) {
+          // Base64 encoded length not a multiple of 4 bytes
           _endOtaUpdate(false, UPDATE_ERROR_MAGIC_BYTE);
-          return true;
+          return;
         }
+
+        // Restart base64-decoder
+        base64_init_decodestate(&_otaBase64State);
+      } else {
+        // Bad firmware format
+        _endOtaUpdate(false, UPDATE_ERROR_MAGIC_BYTE);
+        return;
       }
-      _otaSizeDone = 0;
-      _otaSizeTotal = _otaIsBase64 ? base64_decode_expected_len(total) : total;
-      bool success = Update.begin(_otaSizeTotal);
-      if (!success) {
-        // Detected error during begin (e.g. size == 0 or size > space)
-        _endOtaUpdate(false, Update.getError());
-        return true;
-      }
     }
+    _otaSizeDone = 0;
+    _otaSizeTotal = _otaIsBase64 ? base64_decode_expected_len(total) : total;
+    bool success = Update.begin(_otaSizeTotal);
+    if (!success) {
+      // Detected error during begin (e.g. size == 0 or size > space)
+      _endOtaUpdate(false, Update.getError());
+      return;
+    }
+  }
 
-    size_t write_len;
-    if (_otaIsBase64) {
-      // Base64-firmware: Make sure there are no non-base64 characters in the payload.
-      // libb64/cdecode.c doesn't ignore such characters if the compiler treats `char`
-      // as `unsigned char`.
-      size_t bin_len = 0;
-      char* p = payload;
-      for (size_t i = 0; i < len; i++) {
-        char c = *p++;
-        bool b64 = ((c >= 'A') && (c <= 'Z')) || ((c >= 'a') && (c <= 'z')) || ((c >= '0') && (c <= '9')) || (c == '+') || (c == '/');
-        if (b64) {
-          bin_len++;
-        } else if (c == '=') {
-          // Ignore "=" padding (but only at the end and only up to 2)
-          if (index + i < total - 2) {
-            _endOtaUpdate(false, UPDATE_ERROR_MAGIC_BYTE);
-            return true;
-          }
-          // Note the number of pad characters at the end
-          _otaBase64Pads++;
-        } else {
-          // Non-base64 character in firmware
+  size_t write_len;
+  if (_otaIsBase64) {
+    // Base64-firmware: Make sure there are no non-base64 characters in the payload.
+    // libb64/cdecode.c doesn't ignore such characters if the compiler treats `char`
+    // as `unsigned char`.
+    size_t bin_len = 0;
+    char* p = payload;
+    for (size_t i = 0; i < len; i++) {
+      char c = *p++;
+      bool b64 = ((c >= 'A') && (c <= 'Z')) || ((c >= 'a') && (c <= 'z')) || ((c >= '0') && (c <= '9')) || (c == '+') || (c == '/');
+      if (b64) {
+        bin_len++;
+      } else if (c == '=') {
+        // Ignore "=" padding (but only at the end and only up to 2)
+        if (index + i < total - 2) {
           _endOtaUpdate(false, UPDATE_ERROR_MAGIC_BYTE);
-          return true;
-        }
-      }
-      if (bin_len > 0) {
-        // Decode base64 payload in-place. base64_decode_block() can decode in-place,
-        // except for the first two base64-characters which make one binary byte plus
-        // 4 extra bits (saved in _otaBase64State). So we "manually" decode the first
-        // two characters into a temporary buffer and manually merge that back into
-        // the payload. This one is a little tricky, but it saves us from having to
-        // dynamically allocate some 800 bytes of memory for every payload chunk.
-        size_t dec_len = bin_len > 1 ? 2 : 1;
-        char c;
-        write_len = (size_t)base64_decode_block(payload, dec_len, &c, &_otaBase64State);
-        *payload = c;
-
-        if (bin_len > 1) {
-          write_len += (size_t)base64_decode_block((const char*)payload + dec_len, bin_len - dec_len, payload + write_len, &_otaBase64State);
+          return;
         }
+        // Note the number of pad characters at the end
+        _otaBase64Pads++;
       } else {
-        write_len = 0;
+        // Non-base64 character in firmware
+        _endOtaUpdate(false, UPDATE_ERROR_MAGIC_BYTE);
+        return;
       }
-    } else {
-      // Binary firmware
-      write_len = len;
     }
-    if (write_len > 0) {
-      bool success = Update.write(reinterpret_cast<uint8_t*>(payload), write_len) > 0;
-      if (success) {
-        // Flash write successful.
-        _otaSizeDone += write_len;
-        if (_otaIsBase64 && (index + len == total)) {
-          // Having received the last chunk of base64 encoded firmware, we can now determine
-          // the real size of the binary firmware from the number of padding character ("="):
-          // If we have received 1 pad character, real firmware size modulo 3 was 2.
-          // If we have received 2 pad characters, real firmware size modulo 3 was 1.
-          // Correct the total firmware length accordingly.
-          _otaSizeTotal -= _otaBase64Pads;
-        }
-
-        String progress(_otaSizeDone);
-        progress.concat(F("/"));
-        progress.concat(_otaSizeTotal);
-        Interface::get().getLogger() << F("Receiving OTA firmware (") << progress << F(")...") << endl;
-
-        Interface::get().event.type = HomieEventType::OTA_PROGRESS;
-        Interface::get().event.sizeDone = _otaSizeDone;
-        Interface::get().event.sizeTotal = _otaSizeTotal;
-        Interface::get().eventHandler(Interface::get().event);
-
-        _publishOtaStatus(206, progress.c_str());  // 206 Partial Content
-
-                                                   //  Done with the update?
-        if (index + len == total) {
-          // With base64-coded firmware, we may have provided a length off by one or two
-          // to Update.begin() because the base64-coded firmware may use padding (one or
-          // two "=") at the end. In case of base64, total length was adjusted above.
-          // Check the real length here and ask Update::end() to skip this test.
-          if ((_otaIsBase64) && (_otaSizeDone != _otaSizeTotal)) {
-            _endOtaUpdate(false, UPDATE_ERROR_SIZE);
-            return true;
-          }
-          success = Update.end(_otaIsBase64);
-          _endOtaUpdate(success, Update.getError());
-        }
-      } else {
-        // Error erasing or writing flash
-        _endOtaUpdate(false, Update.getError());
+    if (bin_len > 0) {
+      // Decode base64 payload in-place. base64_decode_block() can decode in-place,
+      // except for the first two base64-characters which make one binary byte plus
+      // 4 extra bits (saved in _otaBase64State). So we "manually" decode the first
+      // two characters into a temporary buffer and manually merge that back into
+      // the payload. This one is a little tricky, but it saves us from having to
+      // dynamically allocate some 800 bytes of memory for every payload chunk.
+      size_t dec_len = bin_len > 1 ? 2 : 1;
+      char c = 0;
+      write_len = (size_t)base64_decode_block(payload, dec_len, &c, &_otaBase64State);
+      *payload = c;
+
+      if (bin_len > 1) {
+        write_len += (size_t)base64_decode_block((const char*)payload + dec_len, bin_len - dec_len, payload + write_len, &_otaBase64State);
       }
+    } else {
+      write_len = 0;
     }
-    return true;
+  } else {
+    // Binary firmware
+    write_len = len;
   }
-  return false;
-}
+  if (write_len > 0) {
+    bool success = Update.write(reinterpret_cast<uint8_t*>(payload), write_len) > 0;
+    if (success) {
+      // Flash write successful.
+      _otaSizeDone += write_len;
+      if (_otaIsBase64 && (index + len == total)) {
+        // Having received the last chunk of base64 encoded firmware, we can now determine
+        // the real size of the binary firmware from the number of padding character ("="):
+        // If we have received 1 pad character, real firmware size modulo 3 was 2.
+        // If we have received 2 pad characters, real firmware size modulo 3 was 1.
+        // Correct the total firmware length accordingly.
+        _otaSizeTotal -= _otaBase64Pads;
+      }
 
-bool HomieInternals::BootNormal::__handleBroadcasts(char * topic, char * payload, const AsyncMqttClientMessageProperties & properties, size_t len, size_t index, size_t total) {
-  if (
-    _mqttTopicLevelsCount == 2
-    && strcmp_P(_mqttTopicLevels.get()[0], PSTR("$broadcast")) == 0
-    ) {
-    String broadcastLevel(_mqttTopicLevels.get()[1]);
-    Interface::get().getLogger() << F("📢 Calling broadcast handler...") << endl;
-    bool handled = Interface::get().broadcastHandler(broadcastLevel, _mqttPayloadBuffer.get());
-    if (!handled) {
-      Interface::get().getLogger() << F("The following broadcast was not handled:") << endl;
-      Interface::get().getLogger() << F("  • Level: ") << broadcastLevel << endl;
-      Interface::get().getLogger() << F("  • Value: ") << _mqttPayloadBuffer.get() << endl;
-    }
-    return true;
-  }
-  return false;
-}
+      String progress(_otaSizeDone);
+      progress.concat(F("/"));
+      progress.concat(_otaSizeTotal);
+      Interface::get().getLogger() << F("Receiving OTA firmware (") << progress << F(")...") << endl;
 
-bool HomieInternals::BootNormal::__handleResets(char * topic, char * payload, const AsyncMqttClientMessageProperties& properties, size_t len, size_t index, size_t total) {
-  if (
-    _mqttTopicLevelsCount == 3
-    && strcmp_P(_mqttTopicLevels.get()[1], PSTR("$implementation")) == 0
-    && strcmp_P(_mqttTopicLevels.get()[2], PSTR("reset")) == 0
-    && strcmp_P(_mqttPayloadBuffer.get(), PSTR("true")) == 0
-    ) {
-    Interface::get().getMqttClient().publish(_prefixMqttTopic(PSTR("/$implementation/reset")), 1, true, "false");
-    Interface::get().getLogger() << F("Flagged for reset by network") << endl;
-    Interface::get().disable = true;
-    Interface::get().reset.resetFlag = true;
-    return true;
-  }
-  return false;
-}
+      Interface::get().event.type = HomieEventType::OTA_PROGRESS;
+      Interface::get().event.sizeDone = _otaSizeDone;
+      Interface::get().event.sizeTotal = _otaSizeTotal;
+      Interface::get().eventHandler(Interface::get().event);
 
-bool HomieInternals::BootNormal::__handleConfig(char * topic, char * payload, const AsyncMqttClientMessageProperties& properties, size_t len, size_t index, size_t total) {
-  if (
-    _mqttTopicLevelsCount == 4
-    && strcmp_P(_mqttTopicLevels.get()[1], PSTR("$implementation")) == 0
-    && strcmp_P(_mqttTopicLevels.get()[2], PSTR("config")) == 0
-    && strcmp_P(_mqttTopicLevels.get()[3], PSTR("set")) == 0
-    ) {
-    Interface::get().getMqttClient().publish(_prefixMqttTopic(PSTR("/$implementation/config/set")), 1, true, "");
-    if (Interface::get().getConfig().patch(_mqttPayloadBuffer.get())) {
-      Interface::get().getLogger() << F("✔ Configuration updated") << endl;
-      _flaggedForReboot = true;
-      Interface::get().getLogger() << F("Flagged for reboot") << endl;
+      _publishOtaStatus(206, progress.c_str());  // 206 Partial Content
+
+      // Done with the update?
+      if (index + len == total) {
+        // With base64-coded firmware, we may have provided a length off by one or two
+        // to Update.begin() because the base64-coded firmware may use padding (one or
+        // two "=") at the end. In case of base64, total length was adjusted above.
+        // Check the real length here and ask Update::end() to skip this test.
+        if ((_otaIsBase64) && (_otaSizeDone != _otaSizeTotal)) {
+          _endOtaUpdate(false, UPDATE_ERROR_SIZE);
+          return;
+        }
+        success = Update.end(_otaIsBase64);
+        _endOtaUpdate(success, Update.getError());
+      }
     } else {
-      Interface::get().getLogger() << F("✖ Configuration not updated") << endl;
+      // Error erasing or writing flash
+      _endOtaUpdate(false, Update.getError());
     }
-    return true;
   }
-  return false;
 }
 
-bool HomieInternals::BootNormal::__handleNodeProperty(char * topic, char * payload, const AsyncMqttClientMessageProperties& properties, size_t len, size_t index, size_t total) {
-  // initialize HomieRange
-  HomieRange range;
-  range.isRange = false;
-  range.index = 0;
+void BootNormal::__handleBroadcasts(const InputMessage& message) {
+  String broadcastLevel(message.level);
+  bool handled = false;
+  for (const InterfaceData::BroadcastSubscription& subscription : Interface::get().broadcastSubscriptions) {
+    if (strcmp(subscription.level, message.level) != 0) continue;
 
-  char* node = _mqttTopicLevels.get()[1];
-  char* property = _mqttTopicLevels.get()[2];
-  HomieNode* homieNode = HomieNode::find(node);
-  if (!homieNode) {
-    Interface::get().getLogger() << F("Node ") << node << F(" not registered") << endl;
-    return true;
+    Interface::get().getLogger() << F("📢 Calling ") << broadcastLevel << F(" broadcast handler...") << endl;
+    handled = subscription.handler(broadcastLevel, message.payload);
+    break;
   }
+  if (handled) return;
 
-#ifdef DEBUG
-  Interface::get().getLogger() << F("Recived network message for ") << homieNode->getId() << endl;
-#endif // DEBUG
-
-  int16_t rangeSeparator = -1;
-  for (uint16_t i = 0; i < strlen(property); i++) {
-    if (property[i] == '_') {
-      rangeSeparator = i;
-      break;
-    }
-  }
-  if (rangeSeparator != -1) {
-    range.isRange = true;
-    property[rangeSeparator] = '\0';
-    char* rangeIndexStr = property + rangeSeparator + 1;
-    String rangeIndexTest = String(rangeIndexStr);
-    for (uint8_t i = 0; i < rangeIndexTest.length(); i++) {
-      if (!isDigit(rangeIndexTest.charAt(i))) {
-        Interface::get().getLogger() << F("Range index ") << rangeIndexStr << F(" is not valid") << endl;
-        return true;
-      }
-    }
-    range.index = rangeIndexTest.toInt();
+  Interface::get().getLogger() << F("📢 Calling broadcast handler...") << endl;
+  handled = Interface::get().broadcastHandler(broadcastLevel, message.payload);
+  if (!handled) {
+    Interface::get().getLogger() << F("The following broadcast was not handled:") << endl;
+    Interface::get().getLogger() << F("  • Level: ") << broadcastLevel << endl;
+    Interface::get().getLogger() << F("  • Value: ") << message.payload << endl;
   }
+}
 
-  Property* propertyObject = nullptr;
-  for (Property* iProperty : homieNode->getProperties()) {
-    if (range.isRange) {
-      if (iProperty->isRange() && strcmp(property, iProperty->getProperty()) == 0) {
-        if (range.index >= iProperty->getLower() && range.index <= iProperty->getUpper()) {
-          propertyObject = iProperty;
-          break;
-        } else {
-          Interface::get().getLogger() << F("Range index ") << range.index << F(" is not within the bounds of ") << property << endl;
-          return true;
-        }
-      }
-    } else if (strcmp(property, iProperty->getProperty()) == 0) {
-      propertyObject = iProperty;
-      break;
-    }
-  }
+void BootNormal::__handleResets(const InputMessage& message) {
+  if (strcmp_P(message.payload, PSTR("true")) != 0) return;
 
-  if (!propertyObject || !propertyObject->isSettable()) {
-    Interface::get().getLogger() << F("Node ") << node << F(": ") << property << F(" property not settable") << endl;
-    return true;
+  Interface::get().getMqttClient().publish(_prefixMqttTopic(PSTR("/$implementation/reset")), 1, true, "false");
+  Interface::get().getLogger() << F("Flagged for reset by network") << endl;
+  Interface::get().disable = true;
+  Interface::get().reset.resetFlag = true;
+}
+
+void BootNormal::__handleConfig(const InputMessage& message) {
+  Interface::get().getMqttClient().publish(_prefixMqttTopic(PSTR("/$implementation/config/set")), 1, true, "");
+  if (Interface::get().getConfig().patch(message.payload)) {
+    Interface::get().getLogger() << F("✔ Configuration updated") << endl;
+    _flaggedForReboot = true;
+    Interface::get().getLogger() << F("Flagged for reboot") << endl;
+  } else {
+    Interface::get().getLogger() << F("✖ Configuration not updated") << endl;
   }
+}
+
+void BootNormal::__handleNodeProperty(const InputMessage& message) {
+  HomieNode* homieNode = message.node;
+  Property* propertyObject = message.property;
+  const HomieRange& range = message.range;
+  const char* property = propertyObject->getProperty();
+  HomieStringView propertyView = { property, strlen(property) };
+  HomieStringView valueView = { message.payload, message.length };
 
 #ifdef DEBUG
   Interface::get().getLogger() << F("Calling global input handler...") << endl;
 #endif // DEBUG
-  bool handled = Interface::get().globalInputHandler(*homieNode, String(property), range, String(_mqttPayloadBuffer.get()));
-  if (handled) return true;
+  bool handled = Interface::get().globalInputHandler(*homieNode, propertyView, range, valueView);
+  if (handled) return;
 
 #ifdef DEBUG
   Interface::get().getLogger() << F("Calling node input handler...") << endl;
 #endif // DEBUG
-  handled = homieNode->handleInput(String(property), range, String(_mqttPayloadBuffer.get()));
-  if (handled) return true;
+  handled = homieNode->handleInputView(propertyView, range, valueView);
+  if (handled) return;
 
 #ifdef DEBUG
   Interface::get().getLogger() << F("Calling property input handler...") << endl;
 #endif // DEBUG
-  handled = propertyObject->getInputHandler()(range, String(_mqttPayloadBuffer.get()));
+  handled = propertyObject->getInputHandler()(range, valueView);
 
   if (!handled) {
     Interface::get().getLogger() << F("No handlers handled the following packet:") << endl;
-    Interface::get().getLogger() << F("  • Node ID: ") << node << endl;
+    Interface::get().getLogger() << F("  • Node ID: ") << homieNode->getId() << endl;
     Interface::get().getLogger() << F("  • Property: ") << property << endl;
     Interface::get().getLogger() << F("  • Is range? ");
     if (range.isRange) {
@@ -925,8 +1374,18 @@ bool HomieInternals::BootNormal::__handleNodeProperty(char * topic, char * paylo
     } else {
       Interface::get().getLogger() << F("no") << endl;
     }
-    Interface::get().getLogger() << F("  • Value: ") << _mqttPayloadBuffer.get() << endl;
+    Interface::get().getLogger() << F("  • Value: ") << message.payload << endl;
   }
+}
 
-  return false;
+void BootNormal::__handleNodePropertyStream(char* topic, char* payload, const AsyncMqttClientMessageProperties& properties, size_t len, size_t index, size_t total) {
+#ifdef DEBUG
+  Interface::get().getLogger() << F("Calling property stream input handler (") << index + len << F("/") << total << F(")...") << endl;
+#endif // DEBUG
+  bool handled = _mqttRouteProperty->getStreamInputHandler()(_mqttRouteRange, payload, len, index, total);
+
+  if (!handled) {
+    _mqttRoute = MqttRoute::UNROUTED;  // drop the remaining chunks
+    Interface::get().getLogger() << F("Stream input for ") << _mqttRouteNode->getId() << F("/") << _mqttRouteProperty->getProperty() << F(" aborted at byte ") << index << endl;
+  }
 }
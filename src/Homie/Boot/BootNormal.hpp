@@ -2,7 +2,9 @@
 
 #include "Arduino.h"
 
+#include <algorithm>
 #include <functional>
+#include <vector>
 #include <libb64/cdecode.h>
 #include <ESP8266WiFi.h>
 #include <ESP8266mDNS.h>
@@ -19,6 +21,8 @@
 #include "../ExponentialBackoffTimer.hpp"
 #include "Boot.hpp"
 #include "../Utils/ResetHandler.hpp"
+#include "../InputQueue.hpp"
+#include "../AdvertisementFingerprint.hpp"
 
 namespace HomieInternals {
 class BootNormal : public Boot {
@@ -31,6 +35,7 @@ class BootNormal : public Boot {
  private:
   struct AdvertisementProgress {
     bool done = false;
+    bool skipUnchanged = false;  // the broker still holds the retained attributes and the subscriptions
     enum class GlobalStep {
       PUB_HOMIE,
       PUB_NAME,
@@ -60,9 +65,58 @@ class BootNormal : public Boot {
     } nodeStep;
 
     size_t currentNodeIndex;
+    size_t currentBroadcastIndex = 0;
+
+    uint16_t inFlightPacketIds[MAX_ADVERTISEMENT_WINDOW];  // not acknowledged yet
+    uint8_t inFlightCount = 0;
   } _advertisementProgress;
+
+  enum class MqttRoute : uint8_t {
+    UNROUTED,
+    OTA_FIRMWARE,
+    BROADCAST,
+    RESET,
+    CONFIG_SET,
+    NODE_PROPERTY,
+    NODE_PROPERTY_STREAM
+  };
+
+  struct ImplementationRoute {
+    uint8_t levelsCount;  // including the device ID and $implementation levels
+    const char* level2;
+    const char* level3;  // nullptr if not checked
+    MqttRoute route;
+  };
+
+  static const ImplementationRoute IMPLEMENTATION_ROUTES[];
+  static const uint8_t IMPLEMENTATION_ROUTES_COUNT;
   Uptime _uptime;
   Timer _statsTimer;
+  enum class StatsStep : uint8_t {  // in publishing order
+    BEGIN,
+    SIGNAL,
+    UPTIME,
+    INPUT_BUFFER,
+    INPUT_REJECTED,
+    INPUT_QUEUE,
+    INPUT_PEAK,
+    INPUT_DROPPED,
+    PUBLISH_SUPPRESSED,
+    PUBLISH_LIMITED,
+    PUBLISH_IN_FLIGHT,
+    PUBLISH_RTT,
+    PUBLISH_TIMEOUTS,
+    PUBLISH_QUEUED,
+    PUBLISH_DROPPED,
+    SPOOL_PENDING,
+    SPOOL_DROPPED,
+    LATENCY_SET,
+    LATENCY_BROADCAST,
+    LATENCY_CONFIG,
+    LATENCY_OTA,
+    LATENCY_PUBLISH,
+    DONE
+  } _statsStep;
   ExponentialBackoffTimer _mqttReconnectTimer;
   bool _setupFunctionCalled;
   WiFiEventHandler _wifiGotIpHandler;
@@ -73,6 +127,20 @@ class BootNormal : public Boot {
   bool _flaggedForReboot;
   uint16_t _mqttOfflineMessageId;
   char _fwChecksum[32 + 1];
+  struct ConnectionTimestamps {  // millis() of each transition towards MQTT_READY, 0 until reached
+    uint32_t startedAt;  // Homie.setup(), or the loss of the previous connection
+    uint32_t wifiConnectAt;
+    uint32_t wifiConnectedAt;
+    uint32_t mqttConnectAt;
+    uint32_t mqttConnectedAt;
+  } _connectionTimestamps;
+  HomieBootTiming _bootTiming;  // of the last connection
+  bool _bootTimingPublished;
+  static const uint8_t BOOT_TIMING_STEPS_COUNT = 5;
+  uint8_t _bootTimingStep;  // next $stats/boot topic
+  uint32_t _advertisementFingerprint;
+  uint32_t _advertisedFingerprint;  // of the last complete advertisement, persisted
+  bool _advertisedFingerprintValid;
   bool _otaIsBase64;
   base64_decodestate _otaBase64State;
   size_t _otaBase64Pads;
@@ -80,34 +148,62 @@ class BootNormal : public Boot {
   size_t _otaSizeDone;
 
   std::unique_ptr<char[]> _mqttTopic;
+  std::unique_ptr<char[]> _advertisementPayloads;  // $nodes then the $properties of each node, null-separated, rendered once at setup
+  std::unique_ptr<const char*[]> _propertiesPayloads;  // per node index, into _advertisementPayloads
 
   std::unique_ptr<char[]> _mqttClientId;
   std::unique_ptr<char[]> _mqttWillTopic;
-  std::unique_ptr<char[]> _mqttPayloadBuffer;
-  std::unique_ptr<char*[]> _mqttTopicLevels;
+  std::unique_ptr<char[]> _mqttPayloadBuffer;  // grow-only, reused across messages
+  size_t _mqttPayloadBufferSize;
+  uint32_t _mqttPayloadRejectedCount;
+  std::unique_ptr<char*[]> _mqttTopicLevels;  // allocated once at setup, sized for the deepest routed topic
+  uint8_t _mqttTopicLevelsCapacity;
   uint8_t _mqttTopicLevelsCount;
+  MqttRoute _mqttRoute;
+  HomieNode* _mqttRouteNode;
+  Property* _mqttRouteProperty;
+  HomieRange _mqttRouteRange;
+  uint32_t _mqttMessageReceivedAt;
+  InputQueue _inputQueue;
 
   void _wifiConnect();
   void _onWifiGotIp(const WiFiEventStationModeGotIP& event);
   void _onWifiDisconnected(const WiFiEventStationModeDisconnected& event);
   void _mqttConnect();
-  void _advertise();
-  void _onMqttConnected();
+  bool _advertise();
+  uint32_t _computeAdvertisementFingerprint();
+  void _renderAdvertisementPayloads();
+  static size_t _renderNodesAttribute(char* buffer);
+  static size_t _renderPropertiesAttribute(const HomieNode& node, char* buffer);
+  static size_t _append(char* buffer, size_t offset, const char* value);
+  void _onMqttConnected(bool sessionPresent);
   void _onMqttDisconnected(AsyncMqttClientDisconnectReason reason);
   void _onMqttMessage(char* topic, char* payload, AsyncMqttClientMessageProperties properties, size_t len, size_t index, size_t total);
   void _onMqttPublish(uint16_t id);
+  void _onMqttSubscribe(uint16_t id, uint8_t qos);
+  void _acknowledgeAdvertisement(uint16_t id);
   void _prefixMqttTopic();
   char* _prefixMqttTopic(PGM_P topic);
+  bool _sendStatistic();  // the current step, false if the client refused it
+  bool _publishStatistic(PGM_P topic, const char* value);
+  bool _publishLatency(PGM_P topic, const __FlashStringHelper* name, LatencyPath path);
+  bool _publishBootTiming();
+  void _connectionLost();
   bool _publishOtaStatus(int status, const char* info = nullptr);
   void _endOtaUpdate(bool success, uint8_t update_error = UPDATE_ERROR_OK);
 
   // _onMqttMessage Helpers
   void __splitTopic(char* topic);
+  void __buildRoutes();
+  void __routeTopic();
+  bool __routeNodeProperty(char* node, char* property);
   bool __fillPayloadBuffer(char* topic, char* payload, const AsyncMqttClientMessageProperties& properties, size_t len, size_t index, size_t total);
-  bool __handleOTAUpdates(char* topic, char* payload, const AsyncMqttClientMessageProperties& properties, size_t len, size_t index, size_t total);
-  bool __handleBroadcasts(char* topic, char* payload, const AsyncMqttClientMessageProperties& properties, size_t len, size_t index, size_t total);
-  bool __handleResets(char* topic, char* payload, const AsyncMqttClientMessageProperties& properties, size_t len, size_t index, size_t total);
-  bool __handleConfig(char* topic, char* payload, const AsyncMqttClientMessageProperties& properties, size_t len, size_t index, size_t total);
-  bool __handleNodeProperty(char* topic, char* payload, const AsyncMqttClientMessageProperties& properties, size_t len, size_t index, size_t total);
+  void __handleInputMessage(const InputMessage& message);
+  void __handleOTAUpdates(char* topic, char* payload, const AsyncMqttClientMessageProperties& properties, size_t len, size_t index, size_t total);
+  void __handleBroadcasts(const InputMessage& message);
+  void __handleResets(const InputMessage& message);
+  void __handleConfig(const InputMessage& message);
+  void __handleNodeProperty(const InputMessage& message);
+  void __handleNodePropertyStream(char* topic, char* payload, const AsyncMqttClientMessageProperties& properties, size_t len, size_t index, size_t total);
 };
 }  // namespace HomieInternals
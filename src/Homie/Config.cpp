@@ -5,7 +5,8 @@ using namespace HomieInternals;
 Config::Config()
   : _configStruct()
   , _spiffsBegan(false)
-  , _valid(false) {
+  , _valid(false)
+  , _safeConfigFile(nullptr) {
 }
 
 bool Config::_spiffsBegin() {
@@ -179,30 +180,39 @@ bool Config::load() {
     }
   }
 
+  // the JSON is already parsed, so this spares a read and a parse on every advertisement
+  _renderSafeConfigFile(parsedJson);
+
   _valid = true;
   return true;
 }
 
-char* Config::getSafeConfigFile() const {
-  File configFile = SPIFFS.open(CONFIG_FILE_PATH, "r");
-  size_t configSize = configFile.size();
+const char* Config::getSafeConfigFile() {
+  if (!_safeConfigFile) {
+    File configFile = SPIFFS.open(CONFIG_FILE_PATH, "r");
+    size_t configSize = configFile.size();
 
-  char buf[MAX_JSON_CONFIG_FILE_SIZE];
-  configFile.readBytes(buf, configSize);
-  configFile.close();
-  buf[configSize] = '\0';
+    char buf[MAX_JSON_CONFIG_FILE_SIZE];
+    configFile.readBytes(buf, configSize);
+    configFile.close();
+    buf[configSize] = '\0';
 
-  StaticJsonBuffer<MAX_JSON_CONFIG_ARDUINOJSON_BUFFER_SIZE> jsonBuffer;
-  JsonObject& parsedJson = jsonBuffer.parseObject(buf);
-  parsedJson["wifi"].as<JsonObject&>().remove("password");
-  parsedJson["mqtt"].as<JsonObject&>().remove("username");
-  parsedJson["mqtt"].as<JsonObject&>().remove("password");
+    StaticJsonBuffer<MAX_JSON_CONFIG_ARDUINOJSON_BUFFER_SIZE> jsonBuffer;
+    JsonObject& parsedJson = jsonBuffer.parseObject(buf);
+    _renderSafeConfigFile(parsedJson);
+  }
+
+  return _safeConfigFile.get();
+}
 
-  size_t jsonBufferLength = parsedJson.measureLength() + 1;
-  std::unique_ptr<char[]> jsonString(new char[jsonBufferLength]);
-  parsedJson.printTo(jsonString.get(), jsonBufferLength);
+void Config::_renderSafeConfigFile(JsonObject& config) {
+  config["wifi"].as<JsonObject&>().remove("password");
+  config["mqtt"].as<JsonObject&>().remove("username");
+  config["mqtt"].as<JsonObject&>().remove("password");
 
-  return strdup(jsonString.get());
+  size_t jsonBufferLength = config.measureLength() + 1;
+  _safeConfigFile = std::unique_ptr<char[]>(new char[jsonBufferLength]);
+  config.printTo(_safeConfigFile.get(), jsonBufferLength);
 }
 
 void Config::erase() {
@@ -210,6 +220,7 @@ void Config::erase() {
 
   SPIFFS.remove(CONFIG_FILE_PATH);
   SPIFFS.remove(CONFIG_NEXT_BOOT_MODE_FILE_PATH);
+  _safeConfigFile.reset();
 }
 
 void Config::setHomieBootModeOnNextBoot(HomieBootMode bootMode) {
@@ -256,6 +267,7 @@ void Config::write(const JsonObject& config) {
 
   config.printTo(configFile);
   configFile.close();
+  _safeConfigFile.reset();
 }
 
 bool Config::patch(const char* patch) {
@@ -2,6 +2,7 @@
 
 #include "Arduino.h"
 
+#include <memory>
 #include <ArduinoJson.h>
 #include "FS.h"
 #include "Datatypes/Interface.hpp"
@@ -20,7 +21,7 @@ class Config {
   Config();
   bool load();
   inline const ConfigStruct& get() const;
-  char* getSafeConfigFile() const;
+  const char* getSafeConfigFile();  // without the secrets, cached until the config file changes
   void erase();
   void setHomieBootModeOnNextBoot(HomieBootMode bootMode);
   HomieBootMode getHomieBootModeOnNextBoot();
@@ -33,8 +34,10 @@ class Config {
   ConfigStruct _configStruct;
   bool _spiffsBegan;
   bool _valid;
+  std::unique_ptr<char[]> _safeConfigFile;  // rendered by load(), nullptr once the file changed
 
   bool _spiffsBegin();
+  void _renderSafeConfigFile(JsonObject& config);
 };
 
 const ConfigStruct& Config::get() const {
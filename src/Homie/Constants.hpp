@@ -21,6 +21,17 @@ namespace HomieInternals {
   const uint32_t STATS_SEND_INTERVAL_SEC = 1 * 60;
   const uint16_t MQTT_RECONNECT_INITIAL_INTERVAL = 1000;
   const uint8_t MQTT_RECONNECT_MAX_BACKOFF = 6;
+  const size_t DEFAULT_MAX_INPUT_PAYLOAD_SIZE = 2048;
+  const uint8_t OUTBOUND_QUEUE_FLUSH_BATCH = 4;
+  const uint32_t DEFAULT_PUBLISH_TIMEOUT = 10 * 1000;
+  const uint16_t OUTBOUND_BLOCKED_RETRY_INTERVAL = 100;
+  const uint8_t DEFAULT_ADVERTISEMENT_WINDOW = 8;
+  const uint32_t ADVERTISEMENT_MAGIC = 0x484D4146;  // HMAF
+  const int16_t DEFAULT_ADVERTISEMENT_RTC_OFFSET = 125;  // in 4-byte blocks, last 12 bytes of the RTC user memory
+  const int16_t MAX_ADVERTISEMENT_RTC_OFFSET = 125;  // the fingerprint takes 3 of the 128 blocks
+  const uint16_t DEFAULT_SPOOL_REPLAY_RATE = 10;
+  const uint32_t SPOOL_FLUSH_INTERVAL = 10 * 1000;
+  const uint32_t SPOOL_MAGIC = 0x484D5350;  // HMSP
 
   const float LED_WIFI_DELAY = 1;
   const float LED_MQTT_DELAY = 0.2;
@@ -28,4 +39,6 @@ namespace HomieInternals {
   const char CONFIG_UI_BUNDLE_PATH[] = "/homie/ui_bundle.gz";
   const char CONFIG_NEXT_BOOT_MODE_FILE_PATH[] = "/homie/NEXTMODE";
   const char CONFIG_FILE_PATH[] = "/homie/config.json";
+  const char SPOOL_FILE_PATH[] = "/homie/spool";
+  const char ADVERTISEMENT_FILE_PATH[] = "/homie/advertisement";
 }  // namespace HomieInternals
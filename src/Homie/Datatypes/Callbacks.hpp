@@ -3,6 +3,7 @@
 #include <functional>
 #include "../../HomieEvent.hpp"
 #include "../../HomieRange.hpp"
+#include "../../HomieStringView.hpp"
 
 class HomieNode;
 
@@ -12,8 +13,15 @@ namespace HomieInternals {
   typedef std::function<bool(const HomieNode& node, const String& property, const HomieRange& range, const String& value)> GlobalInputHandler;
   typedef std::function<bool(const String& property, const HomieRange& range, const String& value)> NodeInputHandler;
   typedef std::function<bool(const HomieRange& range, const String& value)> PropertyInputHandler;
+  typedef std::function<bool(const HomieRange& range, const char* chunk, size_t length, size_t offset, size_t total)> PropertyStreamInputHandler;
+
+  typedef std::function<bool(const HomieNode& node, const HomieStringView& property, const HomieRange& range, const HomieStringView& value)> GlobalInputViewHandler;
+  typedef std::function<bool(const HomieStringView& property, const HomieRange& range, const HomieStringView& value)> NodeInputViewHandler;
+  typedef std::function<bool(const HomieRange& range, const HomieStringView& value)> PropertyInputViewHandler;
 
   typedef std::function<void(const HomieEvent& event)> EventHandler;
 
   typedef std::function<bool(const String& level, const String& value)> BroadcastHandler;
+
+  typedef std::function<void(bool delivered)> PublishCompletionHandler;
 }  // namespace HomieInternals
@@ -11,15 +11,25 @@ InterfaceData::InterfaceData()
   , firmware{ .name = {'\0'}, .version = {'\0'} }
   , led{ .enabled = false, .pin = 0, .on = 0 }
   , reset{ .enabled = false, .idle = false, .triggerPin = 0, .triggerState = 0, .triggerTime = 0, .resetFlag = false }
+  , inbound{ .maxPayloadSize = 0, .queueSize = 0, .queuePolicy = HomieInputQueuePolicy::DROP_OLDEST }
+  , offlineQueue{ .size = 0, .latestPerTopic = false, .spoolCapacity = 0, .spoolReplayRate = 0 }
+  , rateLimit{ .rate = 0, .burst = 0, .policy = HomieRateLimitPolicy::DROP }
+  , advertisement{ .window = DEFAULT_ADVERTISEMENT_WINDOW, .skipUnchanged = false, .rtcOffset = DEFAULT_ADVERTISEMENT_RTC_OFFSET }
   , disable{ false }
   , flaggedForSleep{ false }
   , event{}
   , ready{ false }
+  , setupStartedAt{ 0 }
+  , outbound{ .suppressedCount = 0 }
   , _logger{ nullptr }
   , _blinker{ nullptr }
   , _config{ nullptr }
   , _mqttClient{ nullptr }
-  , _sendingPromise{ nullptr } {
+  , _latency{ nullptr }
+  , _outboundQueue{ nullptr }
+  , _spool{ nullptr }
+  , _publishTracker{ nullptr }
+  , _rateLimiter{ nullptr } {
 }
 
 InterfaceData& Interface::get() {
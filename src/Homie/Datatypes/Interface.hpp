@@ -1,13 +1,21 @@
 #pragma once
 
+#include <vector>
 #include <AsyncMqttClient.h>
 #include "../Logger.hpp"
 #include "../Blinker.hpp"
 #include "../Constants.hpp"
 #include "../Config.hpp"
 #include "../Limits.hpp"
+#include "../Latency.hpp"
+#include "../OutboundQueue.hpp"
+#include "../Spool.hpp"
+#include "../PublishTracker.hpp"
+#include "../RateLimiter.hpp"
 #include "./Callbacks.hpp"
 #include "../../HomieBootMode.hpp"
+#include "../../HomieInputQueuePolicy.hpp"
+#include "../../HomieRateLimitPolicy.hpp"
 #include "../../HomieNode.hpp"
 #include "../../SendingPromise.hpp"
 #include "../../HomieEvent.hpp"
@@ -16,6 +24,11 @@ namespace HomieInternals {
 class Logger;
 class Blinker;
 class Config;
+class Latency;
+class OutboundQueue;
+class Spool;
+class PublishTracker;
+class RateLimiter;
 class SendingPromise;
 class HomieClass;
 
@@ -55,30 +68,74 @@ class InterfaceData {
     bool resetFlag;
   } reset;
 
+  struct Inbound {
+    size_t maxPayloadSize;
+    uint8_t queueSize;
+    HomieInputQueuePolicy queuePolicy;
+  } inbound;
+
+  struct OfflineQueue {
+    uint8_t size;
+    bool latestPerTopic;
+    uint16_t spoolCapacity;
+    uint16_t spoolReplayRate;
+  } offlineQueue;
+
+  struct DeviceRateLimit {
+    float rate;
+    uint16_t burst;
+    HomieRateLimitPolicy policy;
+  } rateLimit;
+
+  struct Advertisement {
+    uint8_t window;
+    bool skipUnchanged;
+    int16_t rtcOffset;  // of the fingerprint, in 4-byte blocks, -1 to keep it in flash only
+  } advertisement;
+
   bool disable;
   bool flaggedForSleep;
 
-  GlobalInputHandler globalInputHandler;
+  GlobalInputViewHandler globalInputHandler;
   BroadcastHandler broadcastHandler;
+  struct BroadcastSubscription {
+    const char* level;  // copied, lives as long as the firmware
+    BroadcastHandler handler;
+    uint8_t qos;
+  };
+  std::vector<BroadcastSubscription> broadcastSubscriptions;  // empty means $broadcast/+
   OperationFunction setupFunction;
   OperationFunction loopFunction;
   EventHandler eventHandler;
+  OperationFunction writableHandler;
 
   /***** Runtime data *****/
   HomieEvent event;
   bool ready;
+  uint32_t setupStartedAt;
+  struct Outbound {
+    uint32_t suppressedCount;
+  } outbound;
   Logger& getLogger() { return *_logger; }
   Blinker& getBlinker() { return *_blinker; }
   Config& getConfig() { return *_config; }
   AsyncMqttClient& getMqttClient() { return *_mqttClient; }
-  SendingPromise& getSendingPromise() { return *_sendingPromise; }
+  Latency& getLatency() { return *_latency; }
+  OutboundQueue& getOutboundQueue() { return *_outboundQueue; }
+  Spool& getSpool() { return *_spool; }
+  PublishTracker& getPublishTracker() { return *_publishTracker; }
+  RateLimiter& getRateLimiter() { return *_rateLimiter; }
 
  private:
   Logger* _logger;
   Blinker* _blinker;
   Config* _config;
   AsyncMqttClient* _mqttClient;
-  SendingPromise* _sendingPromise;
+  Latency* _latency;
+  OutboundQueue* _outboundQueue;
+  Spool* _spool;
+  PublishTracker* _publishTracker;
+  RateLimiter* _rateLimiter;
 };
 
 class Interface {
@@ -0,0 +1,109 @@
+#include "InputQueue.hpp"
+
+using namespace HomieInternals;
+
+InputQueue::InputQueue()
+: _slots(nullptr)
+, _current()
+, _size(0)
+, _policy(HomieInputQueuePolicy::DROP_OLDEST)
+, _head(0)
+, _tail(0)
+, _count(0)
+, _peakDepth(0)
+, _droppedCount(0) {
+}
+
+void InputQueue::setup(uint8_t size, HomieInputQueuePolicy policy) {
+  _size = size;
+  _policy = policy;
+  _head = 0;
+  _tail = 0;
+  _count = 0;
+  _slots = std::unique_ptr<Slot[]>(size > 0 ? new Slot[size]() : nullptr);
+}
+
+bool InputQueue::isEnabled() const {
+  return _size > 0;
+}
+
+void InputQueue::push(const InputMessage& message) {
+  if (_policy == HomieInputQueuePolicy::COALESCE) {
+    for (uint8_t i = 0; i < _count; i++) {
+      Slot* slot = &_slots[(_tail + i) % _size];
+      if (_isSameTopic(slot->message, message)) {
+        _copy(slot, message);  // the pending value is superseded
+        _droppedCount++;
+        return;
+      }
+    }
+  }
+
+  if (_count == _size) {
+    _droppedCount++;
+    if (_policy != HomieInputQueuePolicy::DROP_OLDEST) return;
+
+    _tail = (_tail + 1) % _size;
+    _count--;
+  }
+
+  _copy(&_slots[_head], message);
+  _head = (_head + 1) % _size;
+  _count++;
+  if (_count > _peakDepth) _peakDepth = _count;
+}
+
+bool InputQueue::pop(InputMessage* message) {
+  if (_count == 0) return false;
+
+  // hand the buffer over to the current slot, so that pushes cannot overwrite it while it is handled
+  Slot* slot = &_slots[_tail];
+  std::swap(slot->buffer, _current.buffer);
+  std::swap(slot->bufferSize, _current.bufferSize);
+  *message = slot->message;
+
+  _tail = (_tail + 1) % _size;
+  _count--;
+
+  return true;
+}
+
+uint8_t InputQueue::getDepth() const {
+  return _count;
+}
+
+uint8_t InputQueue::getPeakDepth() const {
+  return _peakDepth;
+}
+
+uint32_t InputQueue::getDroppedCount() const {
+  return _droppedCount;
+}
+
+void InputQueue::_copy(Slot* slot, const InputMessage& message) {
+  size_t levelLength = strlen(message.level);
+  size_t requiredSize = levelLength + 1 + message.length + 1;
+  if (requiredSize > slot->bufferSize) {
+    slot->buffer = std::unique_ptr<char[]>(new char[requiredSize]);
+    slot->bufferSize = requiredSize;
+  }
+
+  char* level = slot->buffer.get();
+  char* payload = level + levelLength + 1;
+  memcpy(level, message.level, levelLength + 1);
+  memcpy(payload, message.payload, message.length);
+  payload[message.length] = '\0';
+
+  slot->message = message;
+  slot->message.level = level;
+  slot->message.payload = payload;
+}
+
+bool InputQueue::_isSameTopic(const InputMessage& a, const InputMessage& b) {
+  return a.route == b.route
+    && a.node == b.node
+    && a.property == b.property
+    && a.range.isRange == b.range.isRange
+    && a.range.index == b.range.index
+    && strcmp(a.level, b.level) == 0;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Arduino.h"
+
+#include <memory>
+#include "../HomieRange.hpp"
+#include "../HomieInputQueuePolicy.hpp"
+
+class HomieNode;
+
+namespace HomieInternals {
+class Property;
+
+struct InputMessage {
+  uint8_t route;
+  HomieNode* node;
+  Property* property;
+  HomieRange range;
+  const char* level;  // broadcast level, empty otherwise
+  const char* payload;  // null-terminated
+  size_t length;
+  uint32_t receivedAt;  // micros() when the first chunk arrived
+};
+
+// Bounded ring of complete inbound messages, filled from the network callbacks and drained from loop().
+// The network callbacks never run concurrently with loop() code that does not yield, so no lock is needed.
+class InputQueue {
+ public:
+  InputQueue();
+  void setup(uint8_t size, HomieInputQueuePolicy policy);
+  bool isEnabled() const;
+  void push(const InputMessage& message);
+  bool pop(InputMessage* message);  // the popped message is valid until the next pop
+  uint8_t getDepth() const;
+  uint8_t getPeakDepth() const;
+  uint32_t getDroppedCount() const;
+
+ private:
+  struct Slot {
+    InputMessage message;
+    std::unique_ptr<char[]> buffer;  // level then payload, grow-only
+    size_t bufferSize;
+  };
+
+  std::unique_ptr<Slot[]> _slots;
+  Slot _current;
+  uint8_t _size;
+  HomieInputQueuePolicy _policy;
+  volatile uint8_t _head;
+  volatile uint8_t _tail;
+  volatile uint8_t _count;
+  uint8_t _peakDepth;
+  uint32_t _droppedCount;
+
+  static void _copy(Slot* slot, const InputMessage& message);
+  static bool _isSameTopic(const InputMessage& a, const InputMessage& b);
+};
+}  // namespace HomieInternals
@@ -0,0 +1,55 @@
+#include "Latency.hpp"
+
+using namespace HomieInternals;
+
+LatencyHistogram::LatencyHistogram()
+: _buckets()
+, _count(0)
+, _max(0) {
+}
+
+void LatencyHistogram::record(uint32_t microseconds) {
+  uint8_t bucket = 0;
+  if (microseconds >= getBucketBound(0)) {
+    bucket = (31 - __builtin_clz(microseconds)) - 6;
+    if (bucket >= LATENCY_BUCKETS_COUNT) bucket = LATENCY_BUCKETS_COUNT - 1;
+  }
+
+  _buckets[bucket]++;
+  _count++;
+  if (microseconds > _max) _max = microseconds;
+}
+
+uint32_t LatencyHistogram::getCount() const {
+  return _count;
+}
+
+uint32_t LatencyHistogram::getMax() const {
+  return _max;
+}
+
+uint32_t LatencyHistogram::getBucket(uint8_t bucket) const {
+  return _buckets[bucket];
+}
+
+void LatencyHistogram::printBuckets(char* buffer) const {
+  char* cursor = buffer;
+  for (uint8_t i = 0; i < LATENCY_BUCKETS_COUNT; i++) {
+    if (i > 0) *cursor++ = ',';
+    ultoa(_buckets[i], cursor, 10);
+    cursor += strlen(cursor);
+  }
+  *cursor = '\0';
+}
+
+uint32_t LatencyHistogram::getBucketBound(uint8_t bucket) {
+  return 128UL << bucket;
+}
+
+Latency::Latency()
+: _histograms() {
+}
+
+LatencyHistogram& Latency::get(LatencyPath path) {
+  return _histograms[static_cast<uint8_t>(path)];
+}
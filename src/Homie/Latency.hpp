@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Arduino.h"
+#include "Limits.hpp"
+
+namespace HomieInternals {
+enum class LatencyPath : uint8_t {
+  INPUT_SET = 0,
+  BROADCAST = 1,
+  CONFIG = 2,
+  OTA_CHUNK = 3,
+  PUBLISH = 4
+};
+
+const uint8_t LATENCY_PATHS_COUNT = 5;
+
+// Log-scale histogram: bucket 0 counts samples under 128µs, each next bucket doubles the bound, the last one is unbounded
+class LatencyHistogram {
+ public:
+  LatencyHistogram();
+  void record(uint32_t microseconds);
+  uint32_t getCount() const;
+  uint32_t getMax() const;
+  uint32_t getBucket(uint8_t bucket) const;
+  void printBuckets(char* buffer) const;  // buffer must hold LATENCY_BUCKETS_COUNT * (10 + 1) chars
+
+  static uint32_t getBucketBound(uint8_t bucket);
+
+ private:
+  uint32_t _buckets[LATENCY_BUCKETS_COUNT];
+  uint32_t _count;
+  uint32_t _max;
+};
+
+class Latency {
+ public:
+  Latency();
+  LatencyHistogram& get(LatencyPath path);
+
+ private:
+  LatencyHistogram _histograms[LATENCY_PATHS_COUNT];
+};
+}  // namespace HomieInternals
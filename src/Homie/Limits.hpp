@@ -32,4 +32,18 @@ namespace HomieInternals {
   const uint8_t MAX_IP_STRING_LENGTH = 16 + 1;
 
   const uint8_t MAX_MAC_STRING_LENGTH = 12;
+
+  const uint8_t MAX_FLOAT_PRECISION = 8;
+  const uint8_t MAX_NUMBER_STRING_LENGTH = 1 + 11 + 1 + MAX_FLOAT_PRECISION + 1;  // 9999999999.999 rounds up to 11 integral digits, larger magnitudes are printed in scientific notation
+
+  const uint8_t LATENCY_BUCKETS_COUNT = 16;
+  const uint8_t MAX_TRACKED_PUBLISHES = 8;
+  const uint8_t MAX_ADVERTISEMENT_WINDOW = 16;
+  const uint16_t MAX_OUTBOUND_BYTES_IN_FLIGHT = 2 * 1460;  // lwIP TCP send buffer, 2 segments
+  const uint8_t MQTT_PUBLISH_OVERHEAD = 1 + 4 + 2 + 2;  // fixed header, topic length, packet ID
+  const uint8_t MAX_RATE_LIMITED_TOPICS = 8;
+  const uint8_t MAX_FILTERED_RANGE_INDEXES = 32;
+
+  const uint8_t SPOOL_RECORD_SIZE = 128;
+  const uint8_t SPOOL_BATCH_SIZE = 8;
 }  // namespace HomieInternals
@@ -0,0 +1,158 @@
+#include "OutboundQueue.hpp"
+#include "Datatypes/Interface.hpp"
+
+using namespace HomieInternals;
+
+OutboundQueue::OutboundQueue()
+: _entries(nullptr)
+, _size(0)
+, _latestPerTopic(false)
+, _head(0)
+, _tail(0)
+, _count(0)
+, _droppedCount(0) {
+}
+
+void OutboundQueue::setup(uint8_t size, bool latestPerTopic) {
+  _size = size;
+  _latestPerTopic = latestPerTopic;
+  _head = 0;
+  _tail = 0;
+  _count = 0;
+  _entries = std::unique_ptr<Entry[]>(size > 0 ? new Entry[size]() : nullptr);
+}
+
+bool OutboundQueue::isEnabled() const {
+  return _size > 0;
+}
+
+bool OutboundQueue::canQueue() const {
+  return isEnabled() || Interface::get().getSpool().isEnabled();
+}
+
+uint16_t OutboundQueue::publish(PublishFilter* publishFilter, const HomieRange& range, const char* topic, uint8_t qos, bool retained, const char* payload, size_t length, uint32_t sentAt, const PublishCompletionHandler& completionHandler, uint32_t timeout, bool* accepted) {
+  Spool& spool = Interface::get().getSpool();
+  if (accepted != nullptr) *accepted = true;
+
+  // spooled and queued publishes go first, to keep the order, and a completion handler needs a tracker entry
+  if (Interface::get().ready && spool.isEmpty() && _count == 0 && (!completionHandler || Interface::get().getPublishTracker().canTrack(qos))) {
+    uint16_t packetId = _publish(topic, qos, retained, payload, length);
+    if (packetId != 0) {
+      Interface::get().getPublishTracker().track(packetId, qos, strlen(topic) + length, sentAt, completionHandler, timeout);
+      if (publishFilter != nullptr) publishFilter->published(range, payload, length);
+      return packetId;
+    }
+    Interface::get().getPublishTracker().rejected();
+  }
+
+  if (isEnabled() && (Interface::get().ready || !spool.isEnabled())) {
+    _push(topic, qos, retained, payload, length, sentAt, completionHandler, timeout);
+    if (publishFilter != nullptr) publishFilter->published(range, payload, length);
+    return 0;
+  }
+
+  // the spool outlives the completion handler, so it only takes the publishes nobody waits for
+  if (!completionHandler && spool.append(topic, qos, retained, payload, length)) {
+    if (publishFilter != nullptr) publishFilter->published(range, payload, length);
+    return 0;
+  }
+
+  if (isEnabled()) {
+    _push(topic, qos, retained, payload, length, sentAt, completionHandler, timeout);
+    if (publishFilter != nullptr) publishFilter->published(range, payload, length);
+    return 0;
+  }
+
+  if (accepted != nullptr) {
+    *accepted = false;
+    return 0;
+  }
+
+  if (completionHandler) completionHandler(false);
+  return 0;
+}
+
+void OutboundQueue::flush() {
+  for (uint8_t i = 0; i < OUTBOUND_QUEUE_FLUSH_BATCH && _count > 0; i++) {
+    Entry* entry = &_entries[_tail];
+    if (entry->completionHandler && !Interface::get().getPublishTracker().canTrack(entry->qos)) return;  // retry once acknowledged
+
+    uint16_t packetId = _publish(entry->topic.get(), entry->qos, entry->retained, entry->payload.get(), entry->payloadLength);
+    if (packetId == 0) {  // client buffer full, retry on next loop
+      Interface::get().getPublishTracker().rejected();
+      return;
+    }
+
+#ifdef DEBUG
+    Interface::get().getLogger() << F("Flushed ") << entry->topic.get() << F(", queued ") << (millis() - entry->queuedAt) << F("ms ago") << endl;
+#endif // DEBUG
+
+    PublishCompletionHandler completionHandler = entry->completionHandler;
+    entry->completionHandler = nullptr;
+    _tail = (_tail + 1) % _size;
+    _count--;
+
+    Interface::get().getPublishTracker().track(packetId, entry->qos, strlen(entry->topic.get()) + entry->payloadLength, entry->sentAt, completionHandler, entry->timeout);
+  }
+}
+
+uint8_t OutboundQueue::getDepth() const {
+  return _count;
+}
+
+uint32_t OutboundQueue::getDroppedCount() const {
+  return _droppedCount;
+}
+
+void OutboundQueue::_push(const char* topic, uint8_t qos, bool retained, const char* payload, size_t length, uint32_t sentAt, const PublishCompletionHandler& completionHandler, uint32_t timeout) {
+  Entry* entry = nullptr;
+
+  if (_latestPerTopic) {
+    for (uint8_t i = 0; i < _count; i++) {
+      Entry* queued = &_entries[(_tail + i) % _size];
+      if (strcmp(queued->topic.get(), topic) == 0) {
+        entry = queued;  // the queued value is superseded, keep its position
+        break;
+      }
+    }
+  }
+
+  if (entry == nullptr) {
+    if (_count == _size) {
+      _droppedCount++;
+      _tail = (_tail + 1) % _size;
+      _count--;
+    }
+
+    entry = &_entries[_head];
+    _copy(&entry->topic, &entry->topicSize, topic, strlen(topic));
+    _head = (_head + 1) % _size;
+    _count++;
+  }
+
+  PublishCompletionHandler supersededCompletionHandler = entry->completionHandler;
+
+  _copy(&entry->payload, &entry->payloadSize, payload, length);
+  entry->payloadLength = length;
+  entry->qos = qos;
+  entry->retained = retained;
+  entry->queuedAt = millis();
+  entry->sentAt = sentAt;
+  entry->completionHandler = completionHandler;
+  entry->timeout = timeout;
+
+  if (supersededCompletionHandler) supersededCompletionHandler(false);
+}
+
+void OutboundQueue::_copy(std::unique_ptr<char[]>* buffer, size_t* bufferSize, const char* value, size_t length) {
+  if (length + 1 > *bufferSize) {
+    *buffer = std::unique_ptr<char[]>(new char[length + 1]);
+    *bufferSize = length + 1;
+  }
+  memcpy(buffer->get(), value, length);
+  buffer->get()[length] = '\0';
+}
+
+uint16_t OutboundQueue::_publish(const char* topic, uint8_t qos, bool retained, const char* payload, size_t length) {
+  return Interface::get().getMqttClient().publish(topic, qos, retained, payload, length);
+}
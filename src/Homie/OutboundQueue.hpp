@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Arduino.h"
+
+#include <memory>
+#include "Constants.hpp"
+#include "PublishFilter.hpp"
+#include "Datatypes/Callbacks.hpp"
+#include "../HomieRange.hpp"
+
+namespace HomieInternals {
+// Bounded ring of publishes made while offline or while the MQTT client buffer was full, flushed once ready
+class OutboundQueue {
+ public:
+  OutboundQueue();
+  void setup(uint8_t size, bool latestPerTopic);
+  bool isEnabled() const;
+  bool canQueue() const;  // this queue or the spool is enabled
+  // 0 if queued or failed, sentAt the micros() of send(), the filter learns the value once published, queued or spooled
+  // with accepted, a failed publish leaves the completion handler to the caller
+  uint16_t publish(PublishFilter* publishFilter, const HomieRange& range, const char* topic, uint8_t qos, bool retained, const char* payload, size_t length, uint32_t sentAt, const PublishCompletionHandler& completionHandler = nullptr, uint32_t timeout = DEFAULT_PUBLISH_TIMEOUT, bool* accepted = nullptr);
+  void flush();
+  uint8_t getDepth() const;
+  uint32_t getDroppedCount() const;
+
+ private:
+  struct Entry {
+    std::unique_ptr<char[]> topic;  // grow-only
+    size_t topicSize;
+    std::unique_ptr<char[]> payload;  // grow-only
+    size_t payloadSize;
+    size_t payloadLength;
+    uint8_t qos;
+    bool retained;
+    uint32_t queuedAt;
+    uint32_t sentAt;  // micros()
+    PublishCompletionHandler completionHandler;
+    uint32_t timeout;
+  };
+
+  std::unique_ptr<Entry[]> _entries;
+  uint8_t _size;
+  bool _latestPerTopic;
+  uint8_t _head;
+  uint8_t _tail;
+  uint8_t _count;
+  uint32_t _droppedCount;
+
+  void _push(const char* topic, uint8_t qos, bool retained, const char* payload, size_t length, uint32_t sentAt, const PublishCompletionHandler& completionHandler, uint32_t timeout);
+  static void _copy(std::unique_ptr<char[]>* buffer, size_t* bufferSize, const char* value, size_t length);
+  static uint16_t _publish(const char* topic, uint8_t qos, bool retained, const char* payload, size_t length);
+};
+}  // namespace HomieInternals
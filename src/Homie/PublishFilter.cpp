@@ -0,0 +1,87 @@
+#include "PublishFilter.hpp"
+
+using namespace HomieInternals;
+
+PublishFilter::PublishFilter(bool range, uint16_t lower, uint16_t upper)
+: _entries()
+, _range(range)
+, _lower(lower)
+, _upper(upper)
+, _absoluteDeadband(0)
+, _relativeDeadband(0)
+, _heartbeatInterval(0) {
+}
+
+void PublishFilter::setDeadband(float absolute, float relative) {
+  _absoluteDeadband = absolute;
+  _relativeDeadband = relative;
+}
+
+void PublishFilter::setHeartbeatInterval(uint32_t interval) {
+  _heartbeatInterval = interval;
+}
+
+bool PublishFilter::isRedundant(const HomieRange& range, const char* value, size_t length) const {
+  if (!_isValid(range)) return false;
+  uint16_t index = _range ? range.index : 0;
+  size_t position = _find(index);
+  if (position == _entries.size() || _entries[position].index != index) return false;
+
+  const Entry* entry = &_entries[position];
+  if (_heartbeatInterval > 0 && millis() - entry->publishedAt >= _heartbeatInterval * 1000UL) return false;
+
+  if (entry->valueLength == length && memcmp(entry->value.get(), value, length) == 0) return true;
+
+  float number;
+  if (!entry->isNumber || !_parseNumber(value, length, &number)) return false;
+
+  float delta = fabs(number - entry->number);
+  float deadband = _relativeDeadband * fabs(entry->number);
+  if (_absoluteDeadband > deadband) deadband = _absoluteDeadband;
+  return delta <= deadband && deadband > 0;
+}
+
+void PublishFilter::published(const HomieRange& range, const char* value, size_t length) {
+  if (!_isValid(range)) return;
+  uint16_t index = _range ? range.index : 0;
+  size_t position = _find(index);
+  if (position == _entries.size() || _entries[position].index != index) {
+    if (_entries.size() >= MAX_FILTERED_RANGE_INDEXES) return;  // the index stays unfiltered
+
+    _entries.insert(_entries.begin() + position, Entry());
+    _entries[position].index = index;
+  }
+
+  Entry* entry = &_entries[position];
+
+  if (length > entry->valueSize) {
+    entry->value = std::unique_ptr<char[]>(new char[length]);
+    entry->valueSize = length;
+  }
+  memcpy(entry->value.get(), value, length);
+  entry->valueLength = length;
+  entry->isNumber = _parseNumber(value, length, &entry->number);
+  entry->publishedAt = millis();
+}
+
+size_t PublishFilter::_find(uint16_t index) const {
+  return std::lower_bound(_entries.begin(), _entries.end(), index, [](const Entry& entry, uint16_t index) {
+    return entry.index < index;
+  }) - _entries.begin();
+}
+
+bool PublishFilter::_isValid(const HomieRange& range) const {
+  if (range.isRange != _range) return false;
+  return !_range || (range.index >= _lower && range.index <= _upper);
+}
+
+bool PublishFilter::_parseNumber(const char* value, size_t length, float* number) {
+  char numberStr[32 + 1];  // values are not null-terminated
+  if (length == 0 || length >= sizeof(numberStr)) return false;
+  memcpy(numberStr, value, length);
+  numberStr[length] = '\0';
+
+  char* end;
+  *number = strtod(numberStr, &end);
+  return *end == '\0';
+}
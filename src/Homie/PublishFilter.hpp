@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Arduino.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include "Limits.hpp"
+#include "../HomieRange.hpp"
+
+namespace HomieInternals {
+// Last published value of a property, per range index, to skip publishing values that did not change.
+// Range indexes get an entry once published, up to MAX_FILTERED_RANGE_INDEXES, the others are never filtered.
+class PublishFilter {
+ public:
+  PublishFilter(bool range, uint16_t lower, uint16_t upper);
+  void setDeadband(float absolute, float relative);
+  void setHeartbeatInterval(uint32_t interval);
+  bool isRedundant(const HomieRange& range, const char* value, size_t length) const;
+  void published(const HomieRange& range, const char* value, size_t length);
+
+ private:
+  struct Entry {
+    uint16_t index;  // 0 unless the property is a range
+    std::unique_ptr<char[]> value;  // grow-only
+    size_t valueSize;
+    size_t valueLength;
+    float number;
+    bool isNumber;
+    uint32_t publishedAt;
+  };
+
+  std::vector<Entry> _entries;  // sorted by index, only the published ones
+  bool _range;
+  uint16_t _lower;
+  uint16_t _upper;
+  float _absoluteDeadband;
+  float _relativeDeadband;
+  uint32_t _heartbeatInterval;
+
+  size_t _find(uint16_t index) const;  // position of the index, or where to insert it
+  bool _isValid(const HomieRange& range) const;
+  static bool _parseNumber(const char* value, size_t length, float* number);
+};
+}  // namespace HomieInternals
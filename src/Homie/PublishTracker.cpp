@@ -0,0 +1,137 @@
+#include "PublishTracker.hpp"
+#include "Datatypes/Interface.hpp"
+
+using namespace HomieInternals;
+
+PublishTracker::PublishTracker()
+: _entries()
+, _inFlightCount(0)
+, _bytesInFlight(0)
+, _blocked(false)
+, _blockedAt(0)
+, _writableWanted(false)
+, _timeoutCount(0)
+, _rttTotal(0)
+, _rttCount(0) {
+}
+
+void PublishTracker::track(uint16_t packetId, uint8_t qos, size_t length, uint32_t sentAt, const PublishCompletionHandler& completionHandler, uint32_t timeout) {
+  if (packetId == 0 || qos == 0) {
+    // nothing to wait for, QoS 0 publishes are as delivered as they will ever be
+    if (completionHandler) completionHandler(packetId != 0);
+    return;
+  }
+
+  for (Entry& entry : _entries) {
+    if (entry.packetId != 0) continue;
+
+    entry.packetId = packetId;
+    entry.sentAt = sentAt;
+    entry.publishedAt = micros();
+    entry.trackedAt = millis();
+    entry.timeout = timeout;
+    entry.completionHandler = completionHandler;
+    entry.size = length + MQTT_PUBLISH_OVERHEAD;
+    _inFlightCount++;
+    _bytesInFlight += entry.size;
+    return;
+  }
+
+  // the table is full, the publish goes untracked
+#ifdef DEBUG
+  Interface::get().getLogger() << F("Too many publishes in flight, not tracking ") << packetId << endl;
+#endif // DEBUG
+
+  if (completionHandler) completionHandler(false);
+}
+
+void PublishTracker::acknowledge(uint16_t packetId) {
+  for (Entry& entry : _entries) {
+    if (entry.packetId != packetId) continue;
+
+    uint32_t now = micros();
+    Interface::get().getLatency().get(LatencyPath::PUBLISH).record(now - entry.sentAt);
+    _rttTotal += (now - entry.publishedAt) / 1000;
+    _rttCount++;
+    _blocked = false;  // the broker got it, so the TCP buffer has drained
+    _complete(&entry, true);
+    return;
+  }
+}
+
+void PublishTracker::rejected() {
+  _blocked = true;
+  _blockedAt = millis();
+  _writableWanted = true;
+}
+
+bool PublishTracker::canPublish(size_t length, uint8_t count) {
+  if (_fits(length, count)) return true;
+
+  _writableWanted = true;
+  return false;
+}
+
+bool PublishTracker::canTrack(uint8_t qos) {
+  if (qos == 0 || _inFlightCount < MAX_TRACKED_PUBLISHES) return true;
+
+  _writableWanted = true;
+  return false;
+}
+
+void PublishTracker::loop() {
+  // QoS 0 publishes are never acknowledged, so assume the buffer drained after a while
+  if (_blocked && millis() - _blockedAt >= OUTBOUND_BLOCKED_RETRY_INTERVAL) _blocked = false;
+
+  if (_inFlightCount > 0) {
+    uint32_t now = millis();
+    for (Entry& entry : _entries) {
+      if (entry.packetId == 0 || now - entry.trackedAt < entry.timeout) continue;
+
+      _timeoutCount++;
+      _complete(&entry, false);
+    }
+  }
+
+  if (_writableWanted && _fits(0, 1)) {
+    _writableWanted = false;
+    if (Interface::get().writableHandler) Interface::get().writableHandler();
+  }
+}
+
+void PublishTracker::clear() {
+  for (Entry& entry : _entries) {
+    if (entry.packetId != 0) _complete(&entry, false);
+  }
+}
+
+uint8_t PublishTracker::getInFlightCount() const {
+  return _inFlightCount;
+}
+
+size_t PublishTracker::getBytesInFlight() const {
+  return _bytesInFlight;
+}
+
+uint32_t PublishTracker::getTimeoutCount() const {
+  return _timeoutCount;
+}
+
+uint32_t PublishTracker::getAverageRtt() const {
+  return _rttCount > 0 ? _rttTotal / _rttCount : 0;
+}
+
+bool PublishTracker::_fits(size_t length, uint8_t count) const {
+  return Interface::get().ready && !_blocked && _inFlightCount + count <= MAX_TRACKED_PUBLISHES && _bytesInFlight + length + MQTT_PUBLISH_OVERHEAD <= MAX_OUTBOUND_BYTES_IN_FLIGHT;
+}
+
+void PublishTracker::_complete(Entry* entry, bool delivered) {
+  // free the entry first, the handler might publish again
+  PublishCompletionHandler completionHandler = entry->completionHandler;
+  entry->packetId = 0;
+  entry->completionHandler = nullptr;
+  _inFlightCount--;
+  _bytesInFlight -= entry->size;
+
+  if (completionHandler) completionHandler(delivered);
+}
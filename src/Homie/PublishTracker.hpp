@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Arduino.h"
+#include "Constants.hpp"
+#include "Limits.hpp"
+#include "Datatypes/Callbacks.hpp"
+
+namespace HomieInternals {
+// Fixed table of the publishes waiting for an acknowledgment, to measure their round trip, notify their sender and estimate the outbound backpressure
+class PublishTracker {
+ public:
+  PublishTracker();
+  void track(uint16_t packetId, uint8_t qos, size_t length, uint32_t sentAt, const PublishCompletionHandler& completionHandler = nullptr, uint32_t timeout = DEFAULT_PUBLISH_TIMEOUT);  // length of the topic and payload, sentAt the micros() of send(), check canTrack() before publishing with a completion handler
+  void acknowledge(uint16_t packetId);
+  void rejected();  // the MQTT client buffer was full
+  bool canPublish(size_t length, uint8_t count = 1);  // count tracked publishes of length bytes in total, one MQTT header included
+  bool canTrack(uint8_t qos);  // a QoS 1 or 2 publish with a completion handler needs a free entry, the others are tracked if one is free
+  void loop();
+  void clear();
+  uint8_t getInFlightCount() const;
+  size_t getBytesInFlight() const;
+  uint32_t getTimeoutCount() const;
+  uint32_t getAverageRtt() const;  // in ms
+
+ private:
+  struct Entry {
+    uint16_t packetId;  // 0 for a free entry
+    uint32_t sentAt;  // micros() when the value was sent, for the latency
+    uint32_t publishedAt;  // micros() when the MQTT client took it, for the round trip
+    uint32_t trackedAt;  // millis() when the MQTT client took it, for the timeout
+    uint32_t timeout;  // in ms
+    uint16_t size;  // in bytes, MQTT header included
+    PublishCompletionHandler completionHandler;
+  };
+
+  Entry _entries[MAX_TRACKED_PUBLISHES];
+  uint8_t _inFlightCount;
+  size_t _bytesInFlight;
+  bool _blocked;
+  uint32_t _blockedAt;
+  bool _writableWanted;
+  uint32_t _timeoutCount;
+  uint32_t _rttTotal;  // in ms
+  uint32_t _rttCount;
+
+  bool _fits(size_t length, uint8_t count) const;
+  void _complete(Entry* entry, bool delivered);
+};
+}  // namespace HomieInternals
@@ -0,0 +1,185 @@
+#include "RateLimiter.hpp"
+#include "Datatypes/Interface.hpp"
+
+using namespace HomieInternals;
+
+TokenBucket::TokenBucket()
+: _interval(0)
+, _capacity(0)
+, _tokens(0)
+, _lastRefill(0) {
+}
+
+void TokenBucket::setup(float rate, uint16_t burst) {
+  _interval = rate > 0 ? static_cast<uint32_t>(1000 / rate) : 0;
+  if (rate > 0 && _interval == 0) _interval = 1;
+  _capacity = burst > 0 ? burst : 1;
+  _tokens = _capacity;
+  _lastRefill = millis();
+}
+
+bool TokenBucket::isEnabled() const {
+  return _interval > 0;
+}
+
+bool TokenBucket::hasToken() {
+  return hasTokens(1);
+}
+
+bool TokenBucket::hasTokens(size_t count) {
+  if (!isEnabled()) return true;
+
+  uint32_t now = millis();
+  uint32_t newTokens = (now - _lastRefill) / _interval;
+  if (newTokens > 0) {
+    if (_tokens + newTokens >= _capacity) {
+      _tokens = _capacity;
+      _lastRefill = now;
+    } else {
+      _tokens += newTokens;
+      _lastRefill += newTokens * _interval;
+    }
+  }
+
+  return _tokens >= count;
+}
+
+void TokenBucket::consume() {
+  if (isEnabled() && _tokens > 0) _tokens--;
+}
+
+void TokenBucket::refund() {
+  if (isEnabled() && _tokens < _capacity) _tokens++;
+}
+
+RateLimiter::RateLimiter()
+: _deviceLimit()
+, _pending()
+, _hitCount(0) {
+  _deviceLimit.policy = HomieRateLimitPolicy::DROP;
+}
+
+void RateLimiter::setup(float rate, uint16_t burst, HomieRateLimitPolicy policy) {
+  _deviceLimit.bucket.setup(rate, burst);
+  _deviceLimit.policy = policy;
+}
+
+bool RateLimiter::allow(RateLimit* propertyLimit, PublishFilter* publishFilter, const HomieRange& range, const char* topic, uint8_t qos, bool retained, const char* payload, size_t length, uint32_t sentAt, const PublishCompletionHandler& completionHandler, uint32_t timeout) {
+  RateLimit* exhaustedLimit = _acquire(propertyLimit);
+  if (exhaustedLimit == nullptr) {
+    _discard(topic);  // it would be published after this newer value
+    return true;
+  }
+
+  _hitCount++;
+  if (exhaustedLimit->policy == HomieRateLimitPolicy::COALESCE && _coalesce(propertyLimit, publishFilter, range, topic, qos, retained, payload, length, sentAt, completionHandler, timeout)) return false;
+
+#ifdef DEBUG
+  Interface::get().getLogger() << F("Rate limit hit, dropping ") << topic << endl;
+#endif // DEBUG
+
+  if (completionHandler) completionHandler(false);
+  return false;
+}
+
+bool RateLimiter::hasTokens(RateLimit* propertyLimit, size_t count) {
+  return (propertyLimit != nullptr ? propertyLimit : &_deviceLimit)->bucket.hasTokens(count);
+}
+
+void RateLimiter::loop() {
+  for (Pending& pending : _pending) {
+    if (!pending.used || _acquire(pending.propertyLimit) != nullptr) continue;
+
+    // free the slot first, the completion handler might publish again and take it
+    Pending sent = std::move(pending);
+    pending.used = false;
+    pending.completionHandler = nullptr;
+    pending.topicSize = 0;
+    pending.payloadSize = 0;
+    bool accepted;
+    Interface::get().getOutboundQueue().publish(sent.publishFilter, sent.range, sent.topic.get(), sent.qos, sent.retained, sent.payload.get(), sent.payloadLength, sent.sentAt, sent.completionHandler, sent.timeout, &accepted);
+
+    if (!accepted) {  // the MQTT client is full, keep the value for a later loop
+      _release(sent.propertyLimit);
+      pending = std::move(sent);
+      return;
+    }
+
+    if (!pending.used) {  // keep the buffers
+      pending.topic = std::move(sent.topic);
+      pending.topicSize = sent.topicSize;
+      pending.payload = std::move(sent.payload);
+      pending.payloadSize = sent.payloadSize;
+    }
+  }
+}
+
+uint32_t RateLimiter::getHitCount() const {
+  return _hitCount;
+}
+
+RateLimit* RateLimiter::_acquire(RateLimit* propertyLimit) {
+  if (propertyLimit != nullptr && !propertyLimit->bucket.hasToken()) return propertyLimit;
+  if (!_deviceLimit.bucket.hasToken()) return &_deviceLimit;
+
+  if (propertyLimit != nullptr) propertyLimit->bucket.consume();
+  _deviceLimit.bucket.consume();
+  return nullptr;
+}
+
+void RateLimiter::_release(RateLimit* propertyLimit) {
+  if (propertyLimit != nullptr) propertyLimit->bucket.refund();
+  _deviceLimit.bucket.refund();
+}
+
+bool RateLimiter::_coalesce(RateLimit* propertyLimit, PublishFilter* publishFilter, const HomieRange& range, const char* topic, uint8_t qos, bool retained, const char* payload, size_t length, uint32_t sentAt, const PublishCompletionHandler& completionHandler, uint32_t timeout) {
+  Pending* slot = nullptr;
+  for (Pending& pending : _pending) {
+    if (pending.used && strcmp(pending.topic.get(), topic) == 0) {
+      slot = &pending;  // replace the pending value
+      break;
+    }
+    if (!pending.used && slot == nullptr) slot = &pending;
+  }
+  if (slot == nullptr) return false;
+
+  PublishCompletionHandler supersededCompletionHandler = slot->used ? slot->completionHandler : nullptr;
+
+  if (!slot->used) _copy(&slot->topic, &slot->topicSize, topic, strlen(topic));
+  _copy(&slot->payload, &slot->payloadSize, payload, length);
+  slot->used = true;
+  slot->propertyLimit = propertyLimit;
+  slot->publishFilter = publishFilter;
+  slot->range = range;
+  slot->payloadLength = length;
+  slot->qos = qos;
+  slot->retained = retained;
+  slot->sentAt = sentAt;
+  slot->completionHandler = completionHandler;
+  slot->timeout = timeout;
+
+  if (supersededCompletionHandler) supersededCompletionHandler(false);
+
+  return true;
+}
+
+void RateLimiter::_discard(const char* topic) {
+  for (Pending& pending : _pending) {
+    if (!pending.used || strcmp(pending.topic.get(), topic) != 0) continue;
+
+    PublishCompletionHandler completionHandler = pending.completionHandler;
+    pending.completionHandler = nullptr;
+    pending.used = false;
+    if (completionHandler) completionHandler(false);
+    return;
+  }
+}
+
+void RateLimiter::_copy(std::unique_ptr<char[]>* buffer, size_t* bufferSize, const char* value, size_t length) {
+  if (length + 1 > *bufferSize) {
+    *buffer = std::unique_ptr<char[]>(new char[length + 1]);
+    *bufferSize = length + 1;
+  }
+  memcpy(buffer->get(), value, length);
+  buffer->get()[length] = '\0';
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Arduino.h"
+
+#include <memory>
+#include "Constants.hpp"
+#include "Limits.hpp"
+#include "PublishFilter.hpp"
+#include "Datatypes/Callbacks.hpp"
+#include "../HomieRateLimitPolicy.hpp"
+
+namespace HomieInternals {
+class TokenBucket {
+ public:
+  TokenBucket();
+  void setup(float rate, uint16_t burst);
+  bool isEnabled() const;
+  bool hasToken();
+  bool hasTokens(size_t count);
+  void consume();
+  void refund();
+
+ private:
+  uint32_t _interval;  // ms per token, 0 if disabled
+  uint16_t _capacity;
+  uint16_t _tokens;
+  uint32_t _lastRefill;
+};
+
+struct RateLimit {
+  TokenBucket bucket;
+  HomieRateLimitPolicy policy;
+};
+
+// Gates publishes on the per-property and per-device token buckets, and holds the coalesced values until a token frees up
+class RateLimiter {
+ public:
+  RateLimiter();
+  void setup(float rate, uint16_t burst, HomieRateLimitPolicy policy);
+  // false if dropped or coalesced, the completion handler is then called by the limiter
+  bool allow(RateLimit* propertyLimit, PublishFilter* publishFilter, const HomieRange& range, const char* topic, uint8_t qos, bool retained, const char* payload, size_t length, uint32_t sentAt, const PublishCompletionHandler& completionHandler = nullptr, uint32_t timeout = DEFAULT_PUBLISH_TIMEOUT);
+  bool hasTokens(RateLimit* propertyLimit, size_t count);  // without consuming them, the device limit for nullptr
+  void loop();
+  uint32_t getHitCount() const;
+
+ private:
+  struct Pending {
+    bool used;
+    RateLimit* propertyLimit;
+    PublishFilter* publishFilter;
+    HomieRange range;
+    std::unique_ptr<char[]> topic;  // grow-only
+    size_t topicSize;
+    std::unique_ptr<char[]> payload;  // grow-only
+    size_t payloadSize;
+    size_t payloadLength;
+    uint8_t qos;
+    bool retained;
+    uint32_t sentAt;  // micros()
+    PublishCompletionHandler completionHandler;
+    uint32_t timeout;
+  };
+
+  RateLimit _deviceLimit;
+  Pending _pending[MAX_RATE_LIMITED_TOPICS];
+  uint32_t _hitCount;
+
+  RateLimit* _acquire(RateLimit* propertyLimit);  // nullptr if a token was consumed, the exhausted limit otherwise
+  void _release(RateLimit* propertyLimit);  // gives back the tokens of a publish that failed
+  bool _coalesce(RateLimit* propertyLimit, PublishFilter* publishFilter, const HomieRange& range, const char* topic, uint8_t qos, bool retained, const char* payload, size_t length, uint32_t sentAt, const PublishCompletionHandler& completionHandler, uint32_t timeout);
+  void _discard(const char* topic);  // a newer value of the topic got a token
+  static void _copy(std::unique_ptr<char[]>* buffer, size_t* bufferSize, const char* value, size_t length);
+};
+}  // namespace HomieInternals
@@ -0,0 +1,210 @@
+#include "Spool.hpp"
+#include "Datatypes/Interface.hpp"
+
+using namespace HomieInternals;
+
+Spool::Spool()
+: _capacity(0)
+, _replayInterval(0)
+, _batch(nullptr)
+, _batchCount(0)
+, _batchStartedAt(0)
+, _nextSequence(1)
+, _flushedSequence(1)
+, _replayedSequence(1)
+, _lastReplayAt(0)
+, _droppedCount(0) {
+}
+
+bool Spool::setup(uint16_t capacity, uint16_t replayRate) {
+  if (capacity == 0) return false;
+
+  File spoolFile = SPIFFS.open(SPOOL_FILE_PATH, "r");
+  Header header;
+  bool valid = spoolFile && spoolFile.read(reinterpret_cast<uint8_t*>(&header), sizeof(header)) == sizeof(header) && header.magic == SPOOL_MAGIC && header.capacity == capacity;
+
+  uint32_t lastSequence = 0;
+  if (valid) {
+    // recover the write position
+    for (uint16_t slot = 0; slot < capacity; slot++) {
+      uint32_t sequence;
+      spoolFile.seek(sizeof(Header) + slot * sizeof(Record));
+      if (spoolFile.read(reinterpret_cast<uint8_t*>(&sequence), sizeof(sequence)) != sizeof(sequence)) {
+        valid = false;
+        break;
+      }
+      if (sequence > lastSequence) lastSequence = sequence;
+    }
+  }
+  if (spoolFile) spoolFile.close();
+
+  if (!valid) {
+    Interface::get().getLogger() << F("Creating spool of ") << capacity << F(" records...") << endl;
+    _capacity = capacity;
+    if (!_create()) {
+      _capacity = 0;
+      Interface::get().getLogger() << F("✖ Cannot create spool") << endl;
+      return false;
+    }
+    header.replayedSequence = 1;
+  }
+
+  _capacity = capacity;
+  _replayInterval = replayRate > 0 ? 1000 / replayRate : 0;
+  _batch = std::unique_ptr<Record[]>(new Record[SPOOL_BATCH_SIZE]);
+  _nextSequence = lastSequence + 1;
+  _flushedSequence = _nextSequence;
+  _replayedSequence = header.replayedSequence;
+  if (_nextSequence > _capacity && _replayedSequence < _nextSequence - _capacity) _replayedSequence = _nextSequence - _capacity;  // overwritten
+  if (_replayedSequence > _nextSequence) _replayedSequence = _nextSequence;
+
+  if (!isEmpty()) Interface::get().getLogger() << F("Spool has ") << getPendingCount() << F(" records to replay") << endl;
+
+  return true;
+}
+
+bool Spool::isEnabled() const {
+  return _capacity > 0;
+}
+
+bool Spool::isEmpty() const {
+  return _replayedSequence == _nextSequence;
+}
+
+bool Spool::append(const char* topic, uint8_t qos, bool retained, const char* payload, size_t payloadLength) {
+  if (!isEnabled()) return false;
+
+  size_t topicLength = strlen(topic);
+  if (topicLength + payloadLength > sizeof(Record::data)) {
+    Interface::get().getLogger() << F("✖ Not spooling ") << topic << F(", topic and payload over ") << sizeof(Record::data) << F(" bytes") << endl;
+    return false;
+  }
+
+  if (_batchCount == 0) _batchStartedAt = millis();
+
+  Record* record = &_batch[_batchCount++];
+  record->sequence = _nextSequence++;
+  record->qos = qos;
+  record->retained = retained;
+  record->topicLength = topicLength;
+  record->payloadLength = payloadLength;
+  memcpy(record->data, topic, topicLength);
+  memcpy(record->data + topicLength, payload, payloadLength);
+
+  if (_nextSequence - _replayedSequence > _capacity) {
+    _replayedSequence++;  // the oldest record gets overwritten
+    _droppedCount++;
+  }
+
+  if (_batchCount == SPOOL_BATCH_SIZE) flush();
+
+  return true;
+}
+
+void Spool::flush() {
+  if (_batchCount == 0) return;
+
+  File spoolFile = SPIFFS.open(SPOOL_FILE_PATH, "r+");
+  if (!spoolFile) {
+    Interface::get().getLogger() << F("✖ Cannot open spool") << endl;
+    return;
+  }
+
+  // the records follow each other in the file, except where the ring wraps around
+  uint8_t runStart = 0;
+  for (uint8_t i = 1; i <= _batchCount; i++) {
+    if (i < _batchCount && _getPosition(_batch[i].sequence, _capacity) != sizeof(Header)) continue;
+
+    spoolFile.seek(_getPosition(_batch[runStart].sequence, _capacity));
+    spoolFile.write(reinterpret_cast<const uint8_t*>(&_batch[runStart]), (i - runStart) * sizeof(Record));
+    runStart = i;
+  }
+  spoolFile.close();
+
+  _flushedSequence = _nextSequence;
+  _batchCount = 0;
+}
+
+void Spool::loop() {
+  if (_batchCount > 0 && millis() - _batchStartedAt >= SPOOL_FLUSH_INTERVAL) flush();
+}
+
+void Spool::replay() {
+  if (isEmpty()) return;
+  if (millis() - _lastReplayAt < _replayInterval) return;
+
+  if (_replayedSequence >= _flushedSequence) flush();  // the next record is still in the batch
+
+  File spoolFile = SPIFFS.open(SPOOL_FILE_PATH, "r+");
+  if (!spoolFile) return;
+
+  Record record;
+  spoolFile.seek(_getPosition(_replayedSequence, _capacity));
+  size_t read = spoolFile.read(reinterpret_cast<uint8_t*>(&record), sizeof(Record));
+
+  _lastReplayAt = millis();
+
+  if (read == sizeof(Record) && record.sequence == _replayedSequence) {
+    char topic[sizeof(Record::data) + 1];
+    memcpy(topic, record.data, record.topicLength);
+    topic[record.topicLength] = '\0';
+
+    uint16_t packetId = Interface::get().getMqttClient().publish(topic, record.qos, record.retained, record.data + record.topicLength, record.payloadLength);
+    if (packetId == 0) {  // client buffer full, retry later
+      spoolFile.close();
+      Interface::get().getPublishTracker().rejected();
+      return;
+    }
+    Interface::get().getPublishTracker().track(packetId, record.qos, record.topicLength + record.payloadLength, micros());  // the record may predate a reboot, so it is timed from its replay
+  } else {
+    _droppedCount++;  // corrupted or lost record, skip it
+  }
+
+  // saved with every record, so that none is replayed twice after a reboot
+  _replayedSequence++;
+  _saveReplayedSequence(&spoolFile);
+  spoolFile.close();
+}
+
+uint32_t Spool::getPendingCount() const {
+  return _nextSequence - _replayedSequence;
+}
+
+uint32_t Spool::getDroppedCount() const {
+  return _droppedCount;
+}
+
+bool Spool::_create() {
+  SPIFFS.remove(SPOOL_FILE_PATH);
+  File spoolFile = SPIFFS.open(SPOOL_FILE_PATH, "w");
+  if (!spoolFile) return false;
+
+  Header header;
+  header.magic = SPOOL_MAGIC;
+  header.capacity = _capacity;
+  header.reserved = 0;
+  header.replayedSequence = 1;
+  spoolFile.write(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+
+  Record record;
+  memset(&record, 0, sizeof(record));
+  for (uint16_t slot = 0; slot < _capacity; slot++) {
+    if (spoolFile.write(reinterpret_cast<const uint8_t*>(&record), sizeof(record)) != sizeof(record)) {
+      spoolFile.close();
+      SPIFFS.remove(SPOOL_FILE_PATH);
+      return false;
+    }
+  }
+  spoolFile.close();
+
+  return true;
+}
+
+void Spool::_saveReplayedSequence(File* spoolFile) {
+  spoolFile->seek(offsetof(Header, replayedSequence));
+  spoolFile->write(reinterpret_cast<const uint8_t*>(&_replayedSequence), sizeof(_replayedSequence));
+}
+
+size_t Spool::_getPosition(uint32_t sequence, uint16_t capacity) {
+  return sizeof(Header) + ((sequence - 1) % capacity) * sizeof(Record);
+}
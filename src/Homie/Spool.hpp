@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Arduino.h"
+
+#include <memory>
+#include <FS.h>
+#include "Limits.hpp"
+
+namespace HomieInternals {
+// Append-only ring of fixed-size publish records on SPIFFS, replayed once ready
+// Record n is stored at slot (n - 1) % capacity, so the write position is recovered from the highest sequence found
+class Spool {
+ public:
+  Spool();
+  bool setup(uint16_t capacity, uint16_t replayRate);
+  bool isEnabled() const;
+  bool isEmpty() const;
+  bool append(const char* topic, uint8_t qos, bool retained, const char* payload, size_t length);
+  void flush();
+  void loop();
+  void replay();
+  uint32_t getPendingCount() const;
+  uint32_t getDroppedCount() const;
+
+ private:
+  struct Header {
+    uint32_t magic;
+    uint16_t capacity;
+    uint16_t reserved;
+    uint32_t replayedSequence;
+  };
+
+  struct Record {
+    uint32_t sequence;  // 0 for an empty slot
+    uint8_t qos;
+    uint8_t retained;
+    uint8_t topicLength;
+    uint8_t payloadLength;
+    char data[SPOOL_RECORD_SIZE - 8];  // topic then payload, not null-terminated
+  };
+
+  uint16_t _capacity;
+  uint16_t _replayInterval;
+  std::unique_ptr<Record[]> _batch;
+  uint8_t _batchCount;
+  uint32_t _batchStartedAt;
+  uint32_t _nextSequence;
+  uint32_t _flushedSequence;
+  uint32_t _replayedSequence;
+  uint32_t _lastReplayAt;
+  uint32_t _droppedCount;
+
+  bool _create();
+  void _saveReplayedSequence(File* spoolFile);
+  static size_t _getPosition(uint32_t sequence, uint16_t capacity);
+};
+}  // namespace HomieInternals
@@ -70,6 +70,21 @@ bool Helpers::validateMd5(const char* md5) {
   return true;
 }
 
+bool Helpers::parseRangeIndex(const char* str, uint16_t* index) {
+  if (*str == '\0') return false;
+
+  uint32_t value = 0;
+  for (const char* c = str; *c != '\0'; c++) {
+    if (*c < '0' || *c > '9') return false;
+
+    value = value * 10 + (*c - '0');
+    if (value > UINT16_MAX) return false;
+  }
+
+  *index = value;
+  return true;
+}
+
 std::unique_ptr<char[]> Helpers::cloneString(const String& string) {
   size_t length = string.length();
   std::unique_ptr<char[]> copy(new char[length + 1]);
@@ -82,3 +97,55 @@ std::unique_ptr<char[]> Helpers::cloneString(const String& string) {
 void Helpers::ipToString(const IPAddress& ip, char * str) {
   snprintf(str, MAX_IP_STRING_LENGTH, "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
 }
+
+size_t Helpers::formatNumber(int value, char* str) {
+  itoa(value, str, 10);
+  return strlen(str);
+}
+
+size_t Helpers::formatNumber(unsigned int value, char* str) {
+  utoa(value, str, 10);
+  return strlen(str);
+}
+
+size_t Helpers::formatNumber(long value, char* str) {
+  ltoa(value, str, 10);
+  return strlen(str);
+}
+
+size_t Helpers::formatNumber(unsigned long value, char* str) {
+  ultoa(value, str, 10);
+  return strlen(str);
+}
+
+size_t Helpers::formatNumber(double value, uint8_t precision, char* str) {
+  if (precision > MAX_FLOAT_PRECISION) precision = MAX_FLOAT_PRECISION;
+
+  if (isnan(value)) {
+    strcpy_P(str, PSTR("nan"));
+    return strlen(str);
+  }
+
+  if (isinf(value)) {
+    strcpy_P(str, value < 0 ? PSTR("-inf") : PSTR("inf"));
+    return strlen(str);
+  }
+
+  if (fabs(value) < 1e10) {
+    dtostrf(value, 0, precision, str);
+    return strlen(str);
+  }
+
+  // dtostrf() prints every integral digit, so print <mantissa>e<exponent> instead
+  int exponent = static_cast<int>(floor(log10(fabs(value))));
+  dtostrf(value / pow(10, exponent), 0, precision, str);
+  if (fabs(atof(str)) >= 10) {  // the mantissa rounded up to 10
+    exponent++;
+    dtostrf(value / pow(10, exponent), 0, precision, str);
+  }
+
+  size_t length = strlen(str);
+  str[length++] = 'e';
+  itoa(exponent, str + length, 10);
+  return strlen(str);
+}
@@ -15,7 +15,14 @@ class Helpers {
   static bool validateIP(const char* ip);
   static bool validateMacAddress(const char* mac);
   static bool validateMd5(const char* md5);
+  static bool parseRangeIndex(const char* str, uint16_t* index);
   static std::unique_ptr<char[]> cloneString(const String& string);
   static void ipToString(const IPAddress& ip, char* str);
+  // str must hold MAX_NUMBER_STRING_LENGTH chars, return the length written
+  static size_t formatNumber(int value, char* str);
+  static size_t formatNumber(unsigned int value, char* str);
+  static size_t formatNumber(long value, char* str);
+  static size_t formatNumber(unsigned long value, char* str);
+  static size_t formatNumber(double value, uint8_t precision, char* str);
 };
 }  // namespace HomieInternals
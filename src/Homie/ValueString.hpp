@@ -0,0 +1,26 @@
+#pragma once
+
+#include "Arduino.h"
+#include "Limits.hpp"
+#include "Utils/Helpers.hpp"
+
+namespace HomieInternals {
+// A typed value printed as it is published, shared by the send() and add() overloads of SendingPromise, PublishHandle and PublishBatch
+class ValueString {
+ public:
+  explicit ValueString(bool value) : _value(value ? "true" : "false"), _length(value ? 4 : 5) {}
+  explicit ValueString(int value) : _value(_buffer), _length(Helpers::formatNumber(value, _buffer)) {}
+  explicit ValueString(unsigned int value) : _value(_buffer), _length(Helpers::formatNumber(value, _buffer)) {}
+  explicit ValueString(long value) : _value(_buffer), _length(Helpers::formatNumber(value, _buffer)) {}
+  explicit ValueString(unsigned long value) : _value(_buffer), _length(Helpers::formatNumber(value, _buffer)) {}
+  ValueString(double value, uint8_t precision) : _value(_buffer), _length(Helpers::formatNumber(value, precision, _buffer)) {}
+
+  const char* get() const { return _value; }
+  size_t length() const { return _length; }
+
+ private:
+  char _buffer[MAX_NUMBER_STRING_LENGTH];
+  const char* _value;  // _buffer, or a literal
+  size_t _length;
+};
+}  // namespace HomieInternals
@@ -17,7 +17,16 @@ enum class HomieEventType : uint8_t {
   MQTT_READY,
   MQTT_DISCONNECTED,
   MQTT_PACKET_ACKNOWLEDGED,
-  READY_TO_SLEEP
+  READY_TO_SLEEP,
+  BOOT_TIMING
+};
+
+struct HomieBootTiming {  // in ms
+  uint32_t setup;  // Homie.setup(), SPIFFS mount and configuration load included, 0 for a reconnection
+  uint32_t wifi;  // from the first Wi-Fi connection attempt to the IP, 0 if Wi-Fi stayed connected
+  uint32_t mqtt;  // from the first MQTT connection attempt to the broker acknowledgment
+  uint32_t advertisement;  // from the broker acknowledgment to MQTT_READY
+  uint32_t total;  // from Homie.setup(), or from the loss of the connection, to MQTT_READY
 };
 
 struct HomieEvent {
@@ -35,4 +44,6 @@ struct HomieEvent {
   /* OTA_PROGRESS */
   size_t sizeDone;
   size_t sizeTotal;
+  /* BOOT_TIMING */
+  HomieBootTiming bootTiming;
 };
@@ -0,0 +1,7 @@
+#pragma once
+
+enum class HomieInputQueuePolicy : uint8_t {
+  DROP_OLDEST = 0,
+  DROP_NEWEST = 1,
+  COALESCE = 2
+};
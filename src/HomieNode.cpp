@@ -4,15 +4,46 @@
 using namespace HomieInternals;
 
 std::vector<HomieNode*> HomieNode::nodes;
+std::vector<HomieNode*> HomieNode::_nodesIndex;
+std::vector<HomieNode::PropertyIndexEntry> HomieNode::_propertiesIndex;
 
 PropertyInterface::PropertyInterface()
 : _property(nullptr) {
 }
 
+void PropertyInterface::settable() {
+  _property->settable([](const HomieRange& range, const HomieStringView& value) { return false; });
+}
+
 void PropertyInterface::settable(const PropertyInputHandler& inputHandler) {
+  _property->settable([inputHandler](const HomieRange& range, const HomieStringView& value) {
+    return inputHandler(range, String(value.data));
+  });
+}
+
+void PropertyInterface::settable(const PropertyInputViewHandler& inputHandler) {
   _property->settable(inputHandler);
 }
 
+void PropertyInterface::settable(const PropertyStreamInputHandler& streamInputHandler) {
+  _property->settable(streamInputHandler);
+}
+
+PropertyInterface& PropertyInterface::suppressDuplicates(uint32_t heartbeatInterval) {
+  _property->filterPublishes(0, 0, heartbeatInterval);
+  return *this;
+}
+
+PropertyInterface& PropertyInterface::setDeadband(float absolute, float relative, uint32_t heartbeatInterval) {
+  _property->filterPublishes(absolute, relative, heartbeatInterval);
+  return *this;
+}
+
+PropertyInterface& PropertyInterface::setRateLimit(float rate, uint16_t burst, HomieRateLimitPolicy policy) {
+  _property->limitPublishes(rate, burst, policy);
+  return *this;
+}
+
 PropertyInterface& PropertyInterface::setProperty(Property* property) {
   _property = property;
   return *this;
@@ -22,7 +53,9 @@ HomieNode::HomieNode(const char* id, const char* type, const NodeInputHandler& i
 : _id(id)
 , _type(type)
 , _properties()
-, _inputHandler(inputHandler) {
+, _inputHandler(inputHandler)
+, _inputViewHandler(nullptr)
+, _stringInput(true) {
   if (strlen(id) + 1 > MAX_NODE_ID_LENGTH || strlen(type) + 1 > MAX_NODE_TYPE_LENGTH) {
     Helpers::abort(F("✖ HomieNode(): either the id or type string is too long"));
     return;  // never reached, here for clarity
@@ -32,6 +65,11 @@ HomieNode::HomieNode(const char* id, const char* type, const NodeInputHandler& i
   HomieNode::nodes.push_back(this);
 }
 
+HomieNode::HomieNode(const char* id, const char* type, const NodeInputViewHandler& inputHandler)
+: HomieNode(id, type) {
+  _inputViewHandler = inputHandler;
+}
+
 HomieNode::~HomieNode() {
     Helpers::abort(F("✖✖ ~HomieNode(): Destruction of HomieNode object not possible\n  Hint: Don't create HomieNode objects as a local variable (e.g. in setup())"));
     return;  // never reached, here for clarity
@@ -53,14 +91,83 @@ PropertyInterface& HomieNode::advertiseRange(const char* property, uint16_t lowe
   return _propertyInterface.setProperty(propertyObject);
 }
 
-SendingPromise& HomieNode::setProperty(const String& property) const {
-  return Interface::get().getSendingPromise().setNode(*this).setProperty(property).setQos(1).setRetained(true).overwriteSetter(false).setRange({ .isRange = false, .index = 0 });
+PropertyInterface& HomieNode::advertiseRange(const char* property, const HomieRangeTableBase& table) {
+  return advertiseRange(property, table.getLower(), table.getUpper());
+}
+
+SendingPromise HomieNode::setProperty(const String& property) const {
+  SendingPromise promise;
+  promise.setNode(*this).setProperty(property).setQos(1).setRetained(true);
+  return promise;
+}
+
+PublishHandle HomieNode::preparePublish(const char* property) const {
+  return PublishHandle(*this, property);
+}
+
+PublishBatch HomieNode::prepareBatch() const {
+  return PublishBatch(*this);
 }
 
 bool HomieNode::handleInput(const String& property, const HomieRange& range, const String& value) {
-  return _inputHandler(property, range, value);
+  if (_inputHandler) return _inputHandler(property, range, value);
+
+  // neither a String handler nor an override, later inputs don't need to build Strings for this node
+  _stringInput = false;
+  return false;
+}
+
+bool HomieNode::handleInputView(const HomieStringView& property, const HomieRange& range, const HomieStringView& value) {
+  if (_inputViewHandler) return _inputViewHandler(property, range, value);
+  if (!_stringInput) return false;
+
+  // nodes without a view input handler go through the String based one, which subclasses might override
+  return handleInput(String(property.data), range, String(value.data));
 }
 
 const std::vector<HomieInternals::Property*>& HomieNode::getProperties() const {
   return _properties;
 }
+
+void HomieNode::buildIndex() {
+  _nodesIndex = HomieNode::nodes;
+  std::sort(_nodesIndex.begin(), _nodesIndex.end(), [](const HomieNode* a, const HomieNode* b) {
+    return strcmp(a->getId(), b->getId()) < 0;
+  });
+
+  _propertiesIndex.clear();
+  for (HomieNode* iNode : _nodesIndex) {
+    for (Property* iProperty : iNode->getProperties()) {
+      _propertiesIndex.push_back({ .node = iNode, .property = iProperty });
+    }
+  }
+  std::stable_sort(_propertiesIndex.begin(), _propertiesIndex.end(), [](const PropertyIndexEntry& a, const PropertyIndexEntry& b) {
+    int nodeComparison = strcmp(a.node->getId(), b.node->getId());
+    if (nodeComparison != 0) return nodeComparison < 0;
+    return strcmp(a.property->getProperty(), b.property->getProperty()) < 0;
+  });
+}
+
+HomieNode* HomieNode::find(const char* id) {
+  auto it = std::lower_bound(_nodesIndex.begin(), _nodesIndex.end(), id, [](const HomieNode* node, const char* id) {
+    return strcmp(node->getId(), id) < 0;
+  });
+  if (it == _nodesIndex.end() || strcmp((*it)->getId(), id) != 0) return nullptr;
+
+  return *it;
+}
+
+Property* HomieNode::findProperty(const char* nodeId, const char* propertyId, HomieNode** node) {
+  auto it = std::lower_bound(_propertiesIndex.begin(), _propertiesIndex.end(), nodeId, [propertyId](const PropertyIndexEntry& entry, const char* nodeId) {
+    int nodeComparison = strcmp(entry.node->getId(), nodeId);
+    if (nodeComparison != 0) return nodeComparison < 0;
+    return strcmp(entry.property->getProperty(), propertyId) < 0;
+  });
+  if (it == _propertiesIndex.end() || strcmp(it->node->getId(), nodeId) != 0 || strcmp(it->property->getProperty(), propertyId) != 0) {
+    *node = find(nodeId);
+    return nullptr;
+  }
+
+  *node = it->node;
+  return it->property;
+}
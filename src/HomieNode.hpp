@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <vector>
 #include "Arduino.h"
@@ -7,7 +8,14 @@
 #include "Homie/Datatypes/Interface.hpp"
 #include "Homie/Datatypes/Callbacks.hpp"
 #include "Homie/Limits.hpp"
+#include "Homie/PublishFilter.hpp"
+#include "Homie/RateLimiter.hpp"
+#include "HomieRateLimitPolicy.hpp"
 #include "HomieRange.hpp"
+#include "HomieRangeTable.hpp"
+#include "HomieStringView.hpp"
+#include "PublishHandle.hpp"
+#include "PublishBatch.hpp"
 
 class HomieNode;
 
@@ -17,6 +25,8 @@ class Property;
 class BootNormal;
 class BootConfig;
 class SendingPromise;
+class PublishHandle;
+class PublishBatch;
 
 class PropertyInterface {
   friend ::HomieNode;
@@ -24,7 +34,13 @@ class PropertyInterface {
  public:
   PropertyInterface();
 
-  void settable(const PropertyInputHandler& inputHandler = [](const HomieRange& range, const String& value) { return false; });
+  void settable();
+  void settable(const PropertyInputHandler& inputHandler);
+  void settable(const PropertyInputViewHandler& inputHandler);
+  void settable(const PropertyStreamInputHandler& streamInputHandler);
+  PropertyInterface& suppressDuplicates(uint32_t heartbeatInterval = 0);
+  PropertyInterface& setDeadband(float absolute, float relative = 0, uint32_t heartbeatInterval = 0);
+  PropertyInterface& setRateLimit(float rate, uint16_t burst = 1, HomieRateLimitPolicy policy = HomieRateLimitPolicy::DROP);
 
  private:
   PropertyInterface& setProperty(Property* property);
@@ -33,25 +49,48 @@ class PropertyInterface {
 };
 
 class Property {
+  friend ::HomieNode;
   friend BootNormal;
+  friend SendingPromise;
+  friend PublishHandle;
+  friend PublishBatch;
 
  public:
-  explicit Property(const char* id, bool range = false, uint16_t lower = 0, uint16_t upper = 0) { _id = strdup(id); _range = range; _lower = lower; _upper = upper; _settable = false; }
-  void settable(const PropertyInputHandler& inputHandler) { _settable = true;  _inputHandler = inputHandler; }
+  explicit Property(const char* id, bool range = false, uint16_t lower = 0, uint16_t upper = 0) { _id = strdup(id); _range = range; _lower = lower; _upper = upper; _settable = false; _streaming = false; }
+  void settable(const PropertyInputViewHandler& inputHandler) { _settable = true;  _inputHandler = inputHandler; }
+  void settable(const PropertyStreamInputHandler& streamInputHandler) { _settable = true; _streaming = true; _streamInputHandler = streamInputHandler; }
+  void filterPublishes(float absoluteDeadband, float relativeDeadband, uint32_t heartbeatInterval) {
+    if (!_publishFilter) _publishFilter.reset(new PublishFilter(_range, _lower, _upper));
+    _publishFilter->setDeadband(absoluteDeadband, relativeDeadband);
+    _publishFilter->setHeartbeatInterval(heartbeatInterval);
+  }
+  void limitPublishes(float rate, uint16_t burst, HomieRateLimitPolicy policy) {
+    if (!_rateLimit) _rateLimit.reset(new RateLimit());
+    _rateLimit->bucket.setup(rate, burst);
+    _rateLimit->policy = policy;
+  }
 
  private:
   const char* getProperty() const { return _id; }
   bool isSettable() const { return _settable; }
+  bool isStreaming() const { return _streaming; }
   bool isRange() const { return _range; }
   uint16_t getLower() const { return _lower; }
   uint16_t getUpper() const { return _upper; }
-  PropertyInputHandler getInputHandler() const { return _inputHandler; }
+  const PropertyInputViewHandler& getInputHandler() const { return _inputHandler; }
+  const PropertyStreamInputHandler& getStreamInputHandler() const { return _streamInputHandler; }
+  PublishFilter* getPublishFilter() const { return _publishFilter.get(); }
+  RateLimit* getRateLimit() const { return _rateLimit.get(); }
   const char* _id;
   bool _range;
   uint16_t _lower;
   uint16_t _upper;
   bool _settable;
-  PropertyInputHandler _inputHandler;
+  bool _streaming;
+  PropertyInputViewHandler _inputHandler;
+  PropertyStreamInputHandler _streamInputHandler;
+  std::unique_ptr<PublishFilter> _publishFilter;  // nullptr unless publishes are filtered
+  std::unique_ptr<RateLimit> _rateLimit;  // nullptr unless publishes are rate limited
 };
 }  // namespace HomieInternals
 
@@ -59,9 +98,13 @@ class HomieNode {
   friend HomieInternals::HomieClass;
   friend HomieInternals::BootNormal;
   friend HomieInternals::BootConfig;
+  friend HomieInternals::SendingPromise;
+  friend HomieInternals::PublishHandle;
+  friend HomieInternals::PublishBatch;
 
  public:
-  HomieNode(const char* id, const char* type, const HomieInternals::NodeInputHandler& nodeInputHandler = [](const String& property, const HomieRange& range, const String& value) { return false; });
+  HomieNode(const char* id, const char* type, const HomieInternals::NodeInputHandler& nodeInputHandler = nullptr);
+  HomieNode(const char* id, const char* type, const HomieInternals::NodeInputViewHandler& nodeInputHandler);
   virtual ~HomieNode();
 
   const char* getId() const { return _id; }
@@ -69,32 +112,41 @@ class HomieNode {
 
   HomieInternals::PropertyInterface& advertise(const char* property);
   HomieInternals::PropertyInterface& advertiseRange(const char* property, uint16_t lower, uint16_t upper);
+  HomieInternals::PropertyInterface& advertiseRange(const char* property, const HomieInternals::HomieRangeTableBase& table);
 
-  HomieInternals::SendingPromise& setProperty(const String& property) const;
+  HomieInternals::SendingPromise setProperty(const String& property) const;
+  HomieInternals::PublishHandle preparePublish(const char* property) const;
+  HomieInternals::PublishBatch prepareBatch() const;
 
  protected:
   virtual void setup() {}
   virtual void loop() {}
   virtual void onReadyToOperate() {}
   virtual bool handleInput(const String& property, const HomieRange& range, const String& value);
+  virtual bool handleInputView(const HomieStringView& property, const HomieRange& range, const HomieStringView& value);
 
  private:
   const std::vector<HomieInternals::Property*>& getProperties() const;
 
-  static HomieNode* find(const char* id) {
-    for (HomieNode* iNode : HomieNode::nodes) {
-      if (strcmp(id, iNode->getId()) == 0) return iNode;
-    }
+  struct PropertyIndexEntry {
+    HomieNode* node;
+    HomieInternals::Property* property;
+  };
 
-    return 0;
-  }
+  static void buildIndex();
+  static HomieNode* find(const char* id);
+  static HomieInternals::Property* findProperty(const char* nodeId, const char* propertyId, HomieNode** node);
 
   const char* _id;
   const char* _type;
   std::vector<HomieInternals::Property*> _properties;
   HomieInternals::NodeInputHandler _inputHandler;
+  HomieInternals::NodeInputViewHandler _inputViewHandler;
+  bool _stringInput;  // cleared once an input reaches HomieNode's own String handleInput() without a handler
 
   HomieInternals::PropertyInterface _propertyInterface;
 
   static std::vector<HomieNode*> nodes;
+  static std::vector<HomieNode*> _nodesIndex;  // sorted by ID, frozen at setup
+  static std::vector<PropertyIndexEntry> _propertiesIndex;  // sorted by node ID then property ID, frozen at setup
 };
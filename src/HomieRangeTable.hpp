@@ -0,0 +1,46 @@
+#pragma once
+
+#include <assert.h>
+#include <memory>
+#include "Arduino.h"
+#include "HomieRange.hpp"
+
+namespace HomieInternals {
+class HomieRangeTableBase {
+ public:
+  uint16_t getLower() const { return _lower; }
+  uint16_t getUpper() const { return _upper; }
+  bool contains(uint16_t index) const { return index >= _lower && index <= _upper; }
+  size_t size() const { return _upper >= _lower ? _upper - _lower + 1 : 0; }
+
+ protected:
+  HomieRangeTableBase(uint16_t lower, uint16_t upper) : _lower(lower), _upper(upper) {}
+
+  uint16_t _lower;
+  uint16_t _upper;
+};
+}  // namespace HomieInternals
+
+// Dense per-index state of a range property, allocated once and indexed in O(1)
+template <class T>
+class HomieRangeTable : public HomieInternals::HomieRangeTableBase {
+ public:
+  HomieRangeTable(uint16_t lower, uint16_t upper, const T& initialValue = T())
+  : HomieRangeTableBase(lower, upper)
+  , _values(new T[size()]) {
+    for (size_t i = 0; i < size(); i++) _values[i] = initialValue;
+  }
+
+  // nullptr if the index is out of the bounds
+  T* at(uint16_t index) { return contains(index) ? &_values[index - _lower] : nullptr; }
+  const T* at(uint16_t index) const { return contains(index) ? &_values[index - _lower] : nullptr; }
+
+  // the index must be within the bounds, use at() otherwise
+  T& operator[](uint16_t index) { assert(contains(index)); return _values[index - _lower]; }
+  const T& operator[](uint16_t index) const { assert(contains(index)); return _values[index - _lower]; }
+  T& operator[](const HomieRange& range) { return (*this)[range.index]; }
+  const T& operator[](const HomieRange& range) const { return (*this)[range.index]; }
+
+ private:
+  std::unique_ptr<T[]> _values;
+};
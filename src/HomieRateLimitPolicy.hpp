@@ -0,0 +1,6 @@
+#pragma once
+
+enum class HomieRateLimitPolicy : uint8_t {
+  DROP = 0,
+  COALESCE = 1
+};
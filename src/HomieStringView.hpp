@@ -0,0 +1,8 @@
+#pragma once
+
+#include <stddef.h>
+
+struct HomieStringView {
+  const char* data;  // null-terminated
+  size_t length;
+};
@@ -0,0 +1,211 @@
+#include "PublishBatch.hpp"
+#include "HomieNode.hpp"
+
+using namespace HomieInternals;
+
+PublishBatch::PublishBatch(const HomieNode& node)
+: _node(&node)
+, _qos(1)
+, _retained(true)
+, _items()
+, _buffer()
+, _topic()
+, _prefixLength(0) {
+}
+
+PublishBatch& PublishBatch::setQos(uint8_t qos) {
+  _qos = qos;
+  return *this;
+}
+
+PublishBatch& PublishBatch::setRetained(bool retained) {
+  _retained = retained;
+  return *this;
+}
+
+PublishBatch& PublishBatch::add(const char* property, const char* value) {
+  return _add(property, { .isRange = false, .index = 0 }, value, strlen(value));
+}
+
+PublishBatch& PublishBatch::add(const char* property, const String& value) {
+  return _add(property, { .isRange = false, .index = 0 }, value.c_str(), value.length());
+}
+
+PublishBatch& PublishBatch::add(const char* property, bool value) {
+  return _add(property, { .isRange = false, .index = 0 }, ValueString(value));
+}
+
+PublishBatch& PublishBatch::add(const char* property, int value) {
+  return _add(property, { .isRange = false, .index = 0 }, ValueString(value));
+}
+
+PublishBatch& PublishBatch::add(const char* property, unsigned int value) {
+  return _add(property, { .isRange = false, .index = 0 }, ValueString(value));
+}
+
+PublishBatch& PublishBatch::add(const char* property, long value) {
+  return _add(property, { .isRange = false, .index = 0 }, ValueString(value));
+}
+
+PublishBatch& PublishBatch::add(const char* property, unsigned long value) {
+  return _add(property, { .isRange = false, .index = 0 }, ValueString(value));
+}
+
+PublishBatch& PublishBatch::add(const char* property, float value, uint8_t precision) {
+  return add(property, static_cast<double>(value), precision);
+}
+
+PublishBatch& PublishBatch::add(const char* property, double value, uint8_t precision) {
+  return _add(property, { .isRange = false, .index = 0 }, ValueString(value, precision));
+}
+
+PublishBatch& PublishBatch::add(const char* property, uint16_t rangeIndex, const char* value) {
+  return _add(property, { .isRange = true, .index = rangeIndex }, value, strlen(value));
+}
+
+size_t PublishBatch::send() {
+  if (_items.empty()) return 0;
+  uint32_t sentAt = micros();  // the publish latency starts here
+
+  if (!Interface::get().ready && !Interface::get().getOutboundQueue().canQueue()) {
+    Interface::get().getLogger() << F("✖ PublishBatch::send(): impossible now") << endl;
+    return 0;
+  }
+
+  // the configuration cannot change without a reboot, so the prefix is built once, by the first send
+  if (_prefixLength == 0) _buildPrefix();
+
+  // all or nothing, so that the snapshot stays together on the wire
+  for (Item& item : _items) {
+    PublishFilter* publishFilter = item.property != nullptr ? item.property->getPublishFilter() : nullptr;
+    item.redundant = publishFilter != nullptr && publishFilter->isRedundant(item.range, &_buffer[item.payloadOffset], item.payloadLength);
+    item.packetId = 0;
+  }
+  if (!_canSend()) return 0;
+
+  size_t sentCount = 0;
+  for (Item& item : _items) {
+    if (item.redundant) {
+      Interface::get().outbound.suppressedCount++;
+      continue;
+    }
+
+    item.packetId = _send(item, sentAt);
+    if (item.packetId != 0) sentCount++;
+  }
+
+  return sentCount;
+}
+
+void PublishBatch::clear() {
+  _items.clear();
+  _buffer.clear();
+}
+
+size_t PublishBatch::getCount() const {
+  return _items.size();
+}
+
+uint16_t PublishBatch::getPacketId(size_t index) const {
+  return index < _items.size() ? _items[index].packetId : 0;
+}
+
+void PublishBatch::_buildPrefix() {
+  const char* baseTopic = Interface::get().getConfig().get().mqtt.baseTopic;
+  const char* deviceId = Interface::get().getConfig().get().deviceId;
+  _prefixLength = strlen(baseTopic) + strlen(deviceId) + 1 + strlen(_node->getId()) + 1;
+  _topic.resize(_prefixLength + 1);
+  strcpy(_topic.data(), baseTopic);
+  strcat(_topic.data(), deviceId);
+  strcat_P(_topic.data(), PSTR("/"));
+  strcat(_topic.data(), _node->getId());
+  strcat_P(_topic.data(), PSTR("/"));
+  _topic.resize(_prefixLength);
+}
+
+PublishBatch& PublishBatch::_add(const char* property, const HomieRange& range, const ValueString& value) {
+  return _add(property, range, value.get(), value.length());
+}
+
+PublishBatch& PublishBatch::_add(const char* property, const HomieRange& range, const char* value, size_t length) {
+  char rangeStr[1 + 5 + 1] = "";  // _65536
+  if (range.isRange) {
+    rangeStr[0] = '_';
+    utoa(range.index, rangeStr + 1, 10);
+  }
+
+  size_t propertyLength = strlen(property);
+  size_t rangeLength = strlen(rangeStr);
+
+  Item item;
+  HomieNode* node;
+  item.property = HomieNode::findProperty(_node->getId(), property, &node);
+  item.range = range;
+  item.suffixOffset = _buffer.size();
+  item.suffixLength = propertyLength + rangeLength;
+  item.payloadOffset = item.suffixOffset + item.suffixLength + 1;
+  item.payloadLength = length;
+  item.redundant = false;
+  item.packetId = 0;
+
+  _buffer.resize(item.payloadOffset + length + 1);
+  char* suffix = &_buffer[item.suffixOffset];
+  memcpy(suffix, property, propertyLength);
+  memcpy(suffix + propertyLength, rangeStr, rangeLength + 1);
+  memcpy(&_buffer[item.payloadOffset], value, length);
+  _buffer[item.payloadOffset + length] = '\0';
+
+  _items.push_back(item);
+  return *this;
+}
+
+bool PublishBatch::_canSend() const {
+  size_t count = 0;
+  size_t length = 0;
+  for (const Item& item : _items) {
+    if (item.redundant) continue;
+    count++;
+    length += _prefixLength + item.suffixLength + item.payloadLength + MQTT_PUBLISH_OVERHEAD;
+  }
+  if (count == 0) return true;
+
+  // a token for every value, from the device limit and from the limit of each property
+  RateLimiter& rateLimiter = Interface::get().getRateLimiter();
+  if (!rateLimiter.hasTokens(nullptr, count)) return false;
+  for (size_t i = 0; i < _items.size(); i++) {
+    RateLimit* propertyLimit = _items[i].property != nullptr ? _items[i].property->getRateLimit() : nullptr;
+    if (_items[i].redundant || propertyLimit == nullptr) continue;
+
+    size_t propertyCount = 0;
+    bool counted = false;  // by an earlier value of the same property
+    for (size_t j = 0; j < _items.size(); j++) {
+      if (_items[j].redundant || _items[j].property != _items[i].property) continue;
+      if (j < i) counted = true;
+      propertyCount++;
+    }
+    if (!counted && !rateLimiter.hasTokens(propertyLimit, propertyCount)) return false;
+  }
+
+  if (!Interface::get().ready) return true;  // queued
+
+  if (length > MAX_OUTBOUND_BYTES_IN_FLIGHT) {
+    Interface::get().getLogger() << F("✖ PublishBatch::send(): batch larger than the MQTT client buffer") << endl;
+    return false;
+  }
+
+  // the values have no completion handler, so they do not need a free tracker entry
+  return Interface::get().getPublishTracker().canPublish(length - MQTT_PUBLISH_OVERHEAD, 0);  // canPublish() accounts for one header
+}
+
+uint16_t PublishBatch::_send(const Item& item, uint32_t sentAt) {
+  // the prefix stays in _topic, only the suffix changes from one item to the next
+  _topic.resize(_prefixLength);
+  _topic.insert(_topic.end(), _buffer.begin() + item.suffixOffset, _buffer.begin() + item.suffixOffset + item.suffixLength + 1);
+  const char* topic = _topic.data();
+  const char* payload = &_buffer[item.payloadOffset];
+
+  PublishFilter* publishFilter = item.property != nullptr ? item.property->getPublishFilter() : nullptr;
+  if (!Interface::get().getRateLimiter().allow(item.property != nullptr ? item.property->getRateLimit() : nullptr, publishFilter, item.range, topic, _qos, _retained, payload, item.payloadLength, sentAt)) return 0;
+
+  return Interface::get().getOutboundQueue().publish(publishFilter, item.range, topic, _qos, _retained, payload, item.payloadLength, sentAt);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+#include "Arduino.h"
+#include "HomieRange.hpp"
+#include "Homie/ValueString.hpp"
+
+class HomieNode;
+
+namespace HomieInternals {
+class Property;
+
+class PublishBatch {
+  friend ::HomieNode;
+
+ public:
+  PublishBatch& setQos(uint8_t qos);
+  PublishBatch& setRetained(bool retained);
+  PublishBatch& add(const char* property, const char* value);
+  PublishBatch& add(const char* property, const String& value);
+  PublishBatch& add(const char* property, bool value);
+  PublishBatch& add(const char* property, int value);
+  PublishBatch& add(const char* property, unsigned int value);
+  PublishBatch& add(const char* property, long value);
+  PublishBatch& add(const char* property, unsigned long value);
+  PublishBatch& add(const char* property, float value, uint8_t precision = 2);
+  PublishBatch& add(const char* property, double value, uint8_t precision = 2);
+  PublishBatch& add(const char* property, uint16_t rangeIndex, const char* value);
+  size_t send();
+  void clear();
+  size_t getCount() const;
+  uint16_t getPacketId(size_t index) const;
+
+ private:
+  struct Item {
+    Property* property;
+    HomieRange range;
+    size_t suffixOffset;  // in _buffer, the property ID and range index that follow the topic prefix
+    size_t suffixLength;
+    size_t payloadOffset;  // in _buffer
+    size_t payloadLength;
+    bool redundant;  // filtered out by the last send()
+    uint16_t packetId;
+  };
+
+  explicit PublishBatch(const HomieNode& node);
+  void _buildPrefix();
+  PublishBatch& _add(const char* property, const HomieRange& range, const ValueString& value);
+  PublishBatch& _add(const char* property, const HomieRange& range, const char* value, size_t length);
+  bool _canSend() const;
+  uint16_t _send(const Item& item, uint32_t sentAt);
+
+  const HomieNode* _node;
+  uint8_t _qos;
+  bool _retained;
+  std::vector<Item> _items;
+  std::vector<char> _buffer;  // the null-terminated topic suffix and payload of each item, kept across clear()
+  std::vector<char> _topic;  // the topic prefix built by the first send(), then the suffix of the item being sent
+  size_t _prefixLength;
+};
+}  // namespace HomieInternals
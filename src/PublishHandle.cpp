@@ -0,0 +1,142 @@
+#include "PublishHandle.hpp"
+#include "HomieNode.hpp"
+
+using namespace HomieInternals;
+
+PublishHandle::PublishHandle(const HomieNode& node, const char* property)
+: _node(&node)
+, _property(new char[strlen(property) + 1])
+, _propertyObject(nullptr)
+, _qos(1)
+, _retained(true)
+, _overwriteSetter(false)
+, _completionHandler(nullptr)
+, _timeout(DEFAULT_PUBLISH_TIMEOUT)
+, _topic(nullptr)
+, _topicLength(0) {
+  strcpy(_property.get(), property);
+}
+
+PublishHandle& PublishHandle::setQos(uint8_t qos) {
+  _qos = qos;
+  return *this;
+}
+
+PublishHandle& PublishHandle::setRetained(bool retained) {
+  _retained = retained;
+  return *this;
+}
+
+PublishHandle& PublishHandle::overwriteSetter(bool overwrite) {
+  _overwriteSetter = overwrite;
+  return *this;
+}
+
+PublishHandle& PublishHandle::setCompletionHandler(const PublishCompletionHandler& completionHandler, uint32_t timeout) {
+  _completionHandler = completionHandler;
+  _timeout = timeout;
+  return *this;
+}
+
+uint16_t PublishHandle::send(const char* value) {
+  return _send({ .isRange = false, .index = 0 }, value, strlen(value));
+}
+
+uint16_t PublishHandle::send(const String& value) {
+  return _send({ .isRange = false, .index = 0 }, value.c_str(), value.length());
+}
+
+uint16_t PublishHandle::send(bool value) {
+  return _send({ .isRange = false, .index = 0 }, ValueString(value));
+}
+
+uint16_t PublishHandle::send(int value) {
+  return _send({ .isRange = false, .index = 0 }, ValueString(value));
+}
+
+uint16_t PublishHandle::send(unsigned int value) {
+  return _send({ .isRange = false, .index = 0 }, ValueString(value));
+}
+
+uint16_t PublishHandle::send(long value) {
+  return _send({ .isRange = false, .index = 0 }, ValueString(value));
+}
+
+uint16_t PublishHandle::send(unsigned long value) {
+  return _send({ .isRange = false, .index = 0 }, ValueString(value));
+}
+
+uint16_t PublishHandle::send(float value, uint8_t precision) {
+  return send(static_cast<double>(value), precision);
+}
+
+uint16_t PublishHandle::send(double value, uint8_t precision) {
+  return _send({ .isRange = false, .index = 0 }, ValueString(value, precision));
+}
+
+uint16_t PublishHandle::send(uint16_t rangeIndex, const char* value) {
+  return _send({ .isRange = true, .index = rangeIndex }, value, strlen(value));
+}
+
+uint16_t PublishHandle::send(uint16_t rangeIndex, const String& value) {
+  return _send({ .isRange = true, .index = rangeIndex }, value.c_str(), value.length());
+}
+
+void PublishHandle::_buildTopic() {
+  const char* baseTopic = Interface::get().getConfig().get().mqtt.baseTopic;
+  const char* deviceId = Interface::get().getConfig().get().deviceId;
+  _topic = std::unique_ptr<char[]>(new char[strlen(baseTopic) + strlen(deviceId) + 1 + strlen(_node->getId()) + 1 + strlen(_property.get()) + 6 + 4 + 1]);  // last + 6 for range _65536, last + 4 for /set
+  strcpy(_topic.get(), baseTopic);
+  strcat(_topic.get(), deviceId);
+  strcat_P(_topic.get(), PSTR("/"));
+  strcat(_topic.get(), _node->getId());
+  strcat_P(_topic.get(), PSTR("/"));
+  strcat(_topic.get(), _property.get());
+  _topicLength = strlen(_topic.get());
+
+  HomieNode* node;
+  _propertyObject = HomieNode::findProperty(_node->getId(), _property.get(), &node);
+}
+
+uint16_t PublishHandle::_send(const HomieRange& range, const ValueString& value) {
+  return _send(range, value.get(), value.length());
+}
+
+uint16_t PublishHandle::_send(const HomieRange& range, const char* value, size_t length) {
+  uint32_t sentAt = micros();  // the publish latency starts here
+
+  if (!Interface::get().ready && !Interface::get().getOutboundQueue().canQueue()) {
+    Interface::get().getLogger() << F("✖ PublishHandle::send(): impossible now") << endl;
+    if (_completionHandler) _completionHandler(false);
+    return 0;
+  }
+
+  // the configuration cannot change without a reboot, so the topic is built once
+  if (!_topic) _buildTopic();
+
+  PublishFilter* publishFilter = _propertyObject != nullptr ? _propertyObject->getPublishFilter() : nullptr;
+  if (publishFilter != nullptr && publishFilter->isRedundant(range, value, length)) {
+    Interface::get().outbound.suppressedCount++;
+    if (_completionHandler) _completionHandler(false);
+    return 0;
+  }
+
+  char* suffix = _topic.get() + _topicLength;
+  if (range.isRange) {
+    *suffix++ = '_';
+    utoa(range.index, suffix, 10);
+    suffix += strlen(suffix);
+  }
+  *suffix = '\0';
+
+  if (!Interface::get().getRateLimiter().allow(_propertyObject != nullptr ? _propertyObject->getRateLimit() : nullptr, publishFilter, range, _topic.get(), _qos, _retained, value, length, sentAt, _completionHandler, _timeout)) return 0;
+
+  uint16_t packetId = Interface::get().getOutboundQueue().publish(publishFilter, range, _topic.get(), _qos, _retained, value, length, sentAt, _completionHandler, _timeout);
+
+  if (_overwriteSetter) {
+    strcpy_P(suffix, PSTR("/set"));
+    Interface::get().getOutboundQueue().publish(nullptr, range, _topic.get(), 1, true, value, length, sentAt);
+  }
+
+  return packetId;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <memory>
+#include "Arduino.h"
+#include "HomieRange.hpp"
+#include "Homie/ValueString.hpp"
+#include "Homie/Constants.hpp"
+#include "Homie/Datatypes/Callbacks.hpp"
+
+class HomieNode;
+
+namespace HomieInternals {
+class Property;
+
+class PublishHandle {
+  friend ::HomieNode;
+
+ public:
+  PublishHandle& setQos(uint8_t qos);
+  PublishHandle& setRetained(bool retained);
+  PublishHandle& overwriteSetter(bool overwrite);
+  PublishHandle& setCompletionHandler(const PublishCompletionHandler& completionHandler, uint32_t timeout = DEFAULT_PUBLISH_TIMEOUT);
+  uint16_t send(const char* value);
+  uint16_t send(const String& value);
+  uint16_t send(bool value);
+  uint16_t send(int value);
+  uint16_t send(unsigned int value);
+  uint16_t send(long value);
+  uint16_t send(unsigned long value);
+  uint16_t send(float value, uint8_t precision = 2);
+  uint16_t send(double value, uint8_t precision = 2);
+  uint16_t send(uint16_t rangeIndex, const char* value);
+  uint16_t send(uint16_t rangeIndex, const String& value);
+
+ private:
+  PublishHandle(const HomieNode& node, const char* property);
+  void _buildTopic();
+  uint16_t _send(const HomieRange& range, const ValueString& value);
+  uint16_t _send(const HomieRange& range, const char* value, size_t length);
+
+  const HomieNode* _node;
+  std::unique_ptr<char[]> _property;  // copied, the caller's string might be a temporary
+  Property* _propertyObject;  // resolved on first send
+  uint8_t _qos;
+  bool _retained;
+  bool _overwriteSetter;
+  PublishCompletionHandler _completionHandler;
+  uint32_t _timeout;
+  std::unique_ptr<char[]> _topic;  // built on first send, with room for the range and /set suffixes
+  size_t _topicLength;  // without any suffix
+};
+}  // namespace HomieInternals
@@ -1,14 +1,39 @@
 #include "SendingPromise.hpp"
+#include "HomieNode.hpp"
 
 using namespace HomieInternals;
 
 SendingPromise::SendingPromise()
 : _node(nullptr)
-, _property(nullptr)
+, _propertyObject(nullptr)
+, _propertyId(nullptr)
+, _propertyIdSize(0)
 , _qos(0)
 , _retained(false)
 , _overwriteSetter(false)
-, _range { .isRange = false, .index = 0 } {
+, _range { .isRange = false, .index = 0 }
+, _completionHandler(nullptr)
+, _timeout(DEFAULT_PUBLISH_TIMEOUT) {
+}
+
+SendingPromise::SendingPromise(const SendingPromise& other)
+: SendingPromise() {
+  *this = other;
+}
+
+SendingPromise& SendingPromise::operator=(const SendingPromise& other) {
+  if (this == &other) return *this;
+
+  _node = other._node;
+  _propertyObject = other._propertyObject;
+  if (other._propertyObject == nullptr) _copyPropertyId(other._propertyId.get());
+  _qos = other._qos;
+  _retained = other._retained;
+  _overwriteSetter = other._overwriteSetter;
+  _range = other._range;
+  _completionHandler = other._completionHandler;
+  _timeout = other._timeout;
+  return *this;
 }
 
 SendingPromise& SendingPromise::setQos(uint8_t qos) {
@@ -39,36 +64,107 @@ SendingPromise& SendingPromise::setRange(uint16_t rangeIndex) {
   return *this;
 }
 
+SendingPromise& SendingPromise::setCompletionHandler(const PublishCompletionHandler& completionHandler, uint32_t timeout) {
+  _completionHandler = completionHandler;
+  _timeout = timeout;
+  return *this;
+}
+
 uint16_t SendingPromise::send(const String& value) {
-  if (!Interface::get().ready) {
+  return _send(value.c_str(), value.length());
+}
+
+uint16_t SendingPromise::send(const char* value) {
+  return _send(value, strlen(value));
+}
+
+uint16_t SendingPromise::send(const char* value, size_t length) {
+  return _send(value, length);
+}
+
+uint16_t SendingPromise::send(bool value) {
+  return _send(ValueString(value));
+}
+
+uint16_t SendingPromise::send(int value) {
+  return _send(ValueString(value));
+}
+
+uint16_t SendingPromise::send(unsigned int value) {
+  return _send(ValueString(value));
+}
+
+uint16_t SendingPromise::send(long value) {
+  return _send(ValueString(value));
+}
+
+uint16_t SendingPromise::send(unsigned long value) {
+  return _send(ValueString(value));
+}
+
+uint16_t SendingPromise::send(float value, uint8_t precision) {
+  return send(static_cast<double>(value), precision);
+}
+
+uint16_t SendingPromise::send(double value, uint8_t precision) {
+  return _send(ValueString(value, precision));
+}
+
+uint16_t SendingPromise::_send(const ValueString& value) {
+  return _send(value.get(), value.length());
+}
+
+uint16_t SendingPromise::_send(const char* value, size_t length) {
+  uint32_t sentAt = micros();  // the publish latency starts here
+
+  if (!Interface::get().ready && !Interface::get().getOutboundQueue().canQueue()) {
     Interface::get().getLogger() << F("✖ setNodeProperty(): impossible now") << endl;
+    if (_completionHandler) _completionHandler(false);
     return 0;
   }
 
-  char* topic = new char[strlen(Interface::get().getConfig().get().mqtt.baseTopic) + strlen(Interface::get().getConfig().get().deviceId) + 1 + strlen(_node->getId()) + 1 + strlen(_property->c_str()) + 6 + 4 + 1];  // last + 6 for range _65536, last + 4 for /set
+  const char* property = getProperty();
+
+  PublishFilter* publishFilter = _propertyObject != nullptr ? _propertyObject->getPublishFilter() : nullptr;
+  if (publishFilter != nullptr && publishFilter->isRedundant(_range, value, length)) {
+    Interface::get().outbound.suppressedCount++;
+    if (_completionHandler) _completionHandler(false);
+    return 0;
+  }
+
+  // on the stack unless the property name is unusually long
+  size_t topicSize = strlen(Interface::get().getConfig().get().mqtt.baseTopic) + strlen(Interface::get().getConfig().get().deviceId) + 1 + strlen(_node->getId()) + 1 + strlen(property) + 6 + 4 + 1;  // last + 6 for range _65536, last + 4 for /set
+  char topicBuffer[MAX_MQTT_TOPIC_LENGTH + 6 + 4];
+  std::unique_ptr<char[]> topicAllocated;
+  char* topic = topicBuffer;
+  if (topicSize > sizeof(topicBuffer)) {
+    topicAllocated = std::unique_ptr<char[]>(new char[topicSize]);
+    topic = topicAllocated.get();
+  }
+
   strcpy(topic, Interface::get().getConfig().get().mqtt.baseTopic);
   strcat(topic, Interface::get().getConfig().get().deviceId);
   strcat_P(topic, PSTR("/"));
   strcat(topic, _node->getId());
   strcat_P(topic, PSTR("/"));
-  strcat(topic, _property->c_str());
+  strcat(topic, property);
 
   if (_range.isRange) {
     char rangeStr[5 + 1];  // max 65536
-    itoa(_range.index, rangeStr, 10);
+    utoa(_range.index, rangeStr, 10);
     strcat_P(topic, PSTR("_"));
     strcat(topic, rangeStr);
   }
 
-  uint16_t packetId = Interface::get().getMqttClient().publish(topic, _qos, _retained, value.c_str());
+  if (!Interface::get().getRateLimiter().allow(_propertyObject != nullptr ? _propertyObject->getRateLimit() : nullptr, publishFilter, _range, topic, _qos, _retained, value, length, sentAt, _completionHandler, _timeout)) return 0;
+
+  uint16_t packetId = Interface::get().getOutboundQueue().publish(publishFilter, _range, topic, _qos, _retained, value, length, sentAt, _completionHandler, _timeout);
 
   if (_overwriteSetter) {
     strcat_P(topic, PSTR("/set"));
-    Interface::get().getMqttClient().publish(topic, 1, true, value.c_str());
+    Interface::get().getOutboundQueue().publish(nullptr, _range, topic, 1, true, value, length, sentAt);
   }
 
-  delete[] topic;
-
   return packetId;
 }
 
@@ -78,7 +174,10 @@ SendingPromise& SendingPromise::setNode(const HomieNode& node) {
 }
 
 SendingPromise& SendingPromise::setProperty(const String& property) {
-  _property = &property;
+  HomieNode* node;
+  _propertyObject = HomieNode::findProperty(_node->getId(), property.c_str(), &node);
+  // the caller's string might be a temporary
+  if (_propertyObject == nullptr) _copyPropertyId(property.c_str());
   return *this;
 }
 
@@ -86,8 +185,8 @@ const HomieNode* SendingPromise::getNode() const {
   return _node;
 }
 
-const String* SendingPromise::getProperty() const {
-  return _property;
+const char* SendingPromise::getProperty() const {
+  return _propertyObject != nullptr ? _propertyObject->getProperty() : _propertyId.get();
 }
 
 uint8_t SendingPromise::getQos() const {
@@ -105,3 +204,12 @@ bool SendingPromise::isRetained() const {
 bool SendingPromise::doesOverwriteSetter() const {
   return _overwriteSetter;
 }
+
+void SendingPromise::_copyPropertyId(const char* property) {
+  size_t size = strlen(property) + 1;
+  if (size > _propertyIdSize) {
+    _propertyId = std::unique_ptr<char[]>(new char[size]);
+    _propertyIdSize = size;
+  }
+  memcpy(_propertyId.get(), property, size);
+}
@@ -1,40 +1,67 @@
 #pragma once
 
 #include "Arduino.h"
+
+#include <memory>
 #include "StreamingOperator.hpp"
 #include "Homie/Datatypes/Interface.hpp"
 #include "HomieRange.hpp"
+#include "Homie/ValueString.hpp"
 
 class HomieNode;
 
 namespace HomieInternals {
+class Property;
+
+// Returned by value from HomieNode::setProperty(), so that sends from timer callbacks and handlers do not clobber each other
 class SendingPromise {
   friend ::HomieNode;
 
  public:
   SendingPromise();
+  SendingPromise(const SendingPromise& other);
+  SendingPromise& operator=(const SendingPromise& other);
+  SendingPromise(SendingPromise&& other) = default;
+  SendingPromise& operator=(SendingPromise&& other) = default;
   SendingPromise& setQos(uint8_t qos);
   SendingPromise& setRetained(bool retained);
   SendingPromise& overwriteSetter(bool overwrite);
   SendingPromise& setRange(const HomieRange& range);
   SendingPromise& setRange(uint16_t rangeIndex);
+  SendingPromise& setCompletionHandler(const PublishCompletionHandler& completionHandler, uint32_t timeout = DEFAULT_PUBLISH_TIMEOUT);
   uint16_t send(const String& value);
+  uint16_t send(const char* value);
+  uint16_t send(const char* value, size_t length);
+  uint16_t send(bool value);
+  uint16_t send(int value);
+  uint16_t send(unsigned int value);
+  uint16_t send(long value);
+  uint16_t send(unsigned long value);
+  uint16_t send(float value, uint8_t precision = 2);
+  uint16_t send(double value, uint8_t precision = 2);
 
  private:
+  uint16_t _send(const ValueString& value);
+  uint16_t _send(const char* value, size_t length);
   SendingPromise& setNode(const HomieNode& node);
   SendingPromise& setProperty(const String& property);
   const HomieNode* getNode() const;
-  const String* getProperty() const;
+  const char* getProperty() const;
   uint8_t getQos() const;
   HomieRange getRange() const;
   bool isRetained() const;
   bool doesOverwriteSetter() const;
+  void _copyPropertyId(const char* property);
 
   const HomieNode* _node;
-  const String* _property;
+  Property* _propertyObject;  // nullptr if not advertised
+  std::unique_ptr<char[]> _propertyId;  // grow-only, copied if not advertised
+  size_t _propertyIdSize;
   uint8_t _qos;
   bool _retained;
   bool _overwriteSetter;
   HomieRange _range;
+  PublishCompletionHandler _completionHandler;
+  uint32_t _timeout;
 };
 }  // namespace HomieInternals